@@ -4,6 +4,8 @@
 
 #include "sokol/hhm.h"
 
+#include <string.h>
+
 //Only for OutputDebugStringA
 #include <Windows.h>
 
@@ -14,6 +16,28 @@ typedef struct {
 } vs_params_t;
 
 
+/* the same shader as C callbacks for the software backend (SOKOL_SOFTWARE) */
+static void sw_vs(const sg_sw_vertex_input* inp, sg_sw_vertex_output* outp)
+{
+    const vs_params_t* params = (const vs_params_t*)inp->uniforms[0];
+    const float* pos = inp->attrs[0];
+    for (int r = 0; r < 4; r++)
+    {
+        outp->position[r] =
+            params->mvp.Elements[0][r] * pos[0] +
+            params->mvp.Elements[1][r] * pos[1] +
+            params->mvp.Elements[2][r] * pos[2] +
+            params->mvp.Elements[3][r];
+    }
+    memcpy(outp->varyings, inp->attrs[1], 4 * sizeof(float));
+}
+
+static bool sw_fs(const sg_sw_fragment_input* inp, float out_color[4])
+{
+    memcpy(out_color, inp->varyings, 4 * sizeof(float));
+    return true;
+}
+
 static sg_buffer m_vbuf;
 static sg_buffer m_ibuf;
 static sg_bindings m_bind;
@@ -114,6 +138,9 @@ void init_handler()
         "float4 main(float4 color: COLOR0): SV_Target0 {\n"
         "  return color;\n"
         "}\n";
+    shdDesc.sw.vs = sw_vs;
+    shdDesc.sw.fs = sw_fs;
+    shdDesc.sw.num_varyings = 4;
     m_shd = sg_make_shader(&shdDesc);
 
     /* a pipeline object */
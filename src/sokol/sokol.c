@@ -2,8 +2,16 @@
 
 #define SOKOL_IMPL
 #define SOKOL_D3D11
+#if defined(SOKOL_GFX_CAPTURE)
+#define SOKOL_TRACE_HOOKS
+#endif
 #include "sokol_gfx.h"
 #include "sokol_glue.h"
+#include "sokol_fgraph.h"
+#if defined(SOKOL_GFX_CAPTURE)
+#include "sokol_gfx_capture.h"
+#endif
+#include "sokol_imm.h"
 
 #define HANDMADE_MATH_IMPLEMENTATION
 #define HANDMADE_MATH_NO_SSE
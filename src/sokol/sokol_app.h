@@ -31,7 +31,7 @@
         SOKOL_NO_ENTRY      - define this if sokol_app.h shouldn't "hijack" the main() function
         SOKOL_API_DECL      - public function declaration prefix (default: extern)
         SOKOL_API_IMPL      - public function implementation prefix (default: -)
-        SOKOL_CALLOC        - your own calloc function (default: calloc(n, s))
+        SOKOL_CALLOC        - your own calloc function (default: calloc(n, s), can be overridden at runtime, see sapp_allocator)
         SOKOL_FREE          - your own free function (default: free(p))
 
     Optionally define the following to force debug checks and validations
@@ -567,6 +567,31 @@
 
     NOTE: SOKOL_NO_ENTRY is currently not supported on Android.
 
+    OPTIONAL: MEMORY ALLOCATION OVERRIDE
+    ====================================
+    By default sokol_app.h allocates heap memory through SOKOL_CALLOC
+    and SOKOL_FREE. To route these allocations through your own allocator
+    at runtime, provide the callbacks in sapp_desc.allocator:
+
+        static void* my_alloc(size_t size, sapp_alloc_category category, void* user_data) { ... }
+        static void my_free(void* ptr, sapp_alloc_category category, void* user_data) { ... }
+
+        sapp_desc sokol_main(int argc, char* argv[]) {
+            return (sapp_desc){
+                ...
+                .allocator = {
+                    .alloc_fn = my_alloc,
+                    .free_fn = my_free,
+                    .user_data = ...
+                }
+            };
+        }
+
+    Either both or none of the callbacks must be provided. The memory
+    returned by alloc_fn() doesn't need to be zero-initialized. On Windows
+    the UTF-8 command line arguments are converted before sokol_main() is
+    called, this allocation always goes through SOKOL_CALLOC.
+
     TEMP NOTE DUMP
     ==============
     - onscreen keyboard support on Android requires Java :(, should we even bother?
@@ -608,6 +633,7 @@
         distribution.
 */
 #define SOKOL_APP_INCLUDED (1)
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -824,6 +850,20 @@ typedef struct sapp_event {
     int framebuffer_height;
 } sapp_event;
 
+/* categories passed to the sapp_allocator callbacks */
+typedef enum sapp_alloc_category {
+    SAPP_ALLOCCATEGORY_CLIPBOARD,       /* the clipboard buffer (see sapp_desc.clipboard_size) */
+    SAPP_ALLOCCATEGORY_TEMP,            /* short-lived scratch memory during setup */
+    _SAPP_ALLOCCATEGORY_NUM
+} sapp_alloc_category;
+
+/* optional runtime allocator, see MEMORY ALLOCATION OVERRIDE */
+typedef struct sapp_allocator {
+    void* (*alloc_fn)(size_t size, sapp_alloc_category category, void* user_data);
+    void (*free_fn)(void* ptr, sapp_alloc_category category, void* user_data);
+    void* user_data;
+} sapp_allocator;
+
 typedef struct sapp_desc {
     void (*init_cb)(void);                  /* these are the user-provided callbacks without user data */
     void (*frame_cb)(void);
@@ -857,6 +897,7 @@ typedef struct sapp_desc {
     bool html5_ask_leave_site;          /* initial state of the internal html5_ask_leave_site flag (see sapp_html5_ask_leave_site()) */
     bool ios_keyboard_resizes_canvas;   /* if true, showing the iOS keyboard shrinks the canvas */
     bool gl_force_gles2;                /* if true, setup GLES2/WebGL even if GLES3/WebGL2 is available */
+    sapp_allocator allocator;           /* optional allocator callbacks, default is SOKOL_CALLOC/SOKOL_FREE */
 } sapp_desc;
 
 /* user-provided functions */
@@ -1675,6 +1716,31 @@ typedef struct {
 } _sapp_t;
 static _sapp_t _sapp;
 
+_SOKOL_PRIVATE void* _sapp_calloc(size_t num, size_t size, sapp_alloc_category category) {
+    if (_sapp.desc.allocator.alloc_fn) {
+        void* ptr = _sapp.desc.allocator.alloc_fn(num * size, category, _sapp.desc.allocator.user_data);
+        if (ptr) {
+            memset(ptr, 0, num * size);
+        }
+        return ptr;
+    }
+    else {
+        return SOKOL_CALLOC(num, size);
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_free(void* ptr, sapp_alloc_category category) {
+    if (0 == ptr) {
+        return;
+    }
+    if (_sapp.desc.allocator.free_fn) {
+        _sapp.desc.allocator.free_fn(ptr, category, _sapp.desc.allocator.user_data);
+    }
+    else {
+        SOKOL_FREE(ptr);
+    }
+}
+
 /*=== OPTIONAL MINI GL LOADER FOR WIN32/WGL ==================================*/
 #if defined(_SAPP_WIN32) && defined(SOKOL_GLCORE33) && !defined(SOKOL_WIN32_NO_GL_LOADER)
 #define __gl_h_ 1
@@ -2134,6 +2200,7 @@ _SOKOL_PRIVATE sapp_desc _sapp_desc_defaults(const sapp_desc* in_desc) {
 _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
     _SAPP_CLEAR(_sapp_t, _sapp);
     _sapp.desc = _sapp_desc_defaults(desc);
+    SOKOL_ASSERT((0 == _sapp.desc.allocator.alloc_fn) == (0 == _sapp.desc.allocator.free_fn));
     _sapp.first_frame = true;
     _sapp.window_width = _sapp.desc.width;
     _sapp.window_height = _sapp.desc.height;
@@ -2147,7 +2214,7 @@ _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
     _sapp.clipboard_enabled = _sapp.desc.enable_clipboard;
     if (_sapp.clipboard_enabled) {
         _sapp.clipboard_size = _sapp.desc.clipboard_size;
-        _sapp.clipboard = (char*) SOKOL_CALLOC(1, _sapp.clipboard_size);
+        _sapp.clipboard = (char*) _sapp_calloc(1, (size_t)_sapp.clipboard_size, SAPP_ALLOCCATEGORY_CLIPBOARD);
     }
     _sapp_strcpy(_sapp.desc.window_title, _sapp.window_title, sizeof(_sapp.window_title));
     _sapp.desc.window_title = _sapp.window_title;
@@ -2159,7 +2226,7 @@ _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
 _SOKOL_PRIVATE void _sapp_discard_state(void) {
     if (_sapp.clipboard_enabled) {
         SOKOL_ASSERT(_sapp.clipboard);
-        SOKOL_FREE((void*)_sapp.clipboard);
+        _sapp_free((void*)_sapp.clipboard, SAPP_ALLOCCATEGORY_CLIPBOARD);
     }
     _SAPP_CLEAR(_sapp_t, _sapp);
 }
@@ -4541,7 +4608,7 @@ _SOKOL_PRIVATE int _sapp_wgl_find_pixel_format(void) {
     const _sapp_gl_fbconfig* closest;
 
     int native_count = _sapp_wgl_attrib(1, WGL_NUMBER_PIXEL_FORMATS_ARB);
-    _sapp_gl_fbconfig* usable_configs = (_sapp_gl_fbconfig*) SOKOL_CALLOC(native_count, sizeof(_sapp_gl_fbconfig));
+    _sapp_gl_fbconfig* usable_configs = (_sapp_gl_fbconfig*) _sapp_calloc((size_t)native_count, sizeof(_sapp_gl_fbconfig), SAPP_ALLOCCATEGORY_TEMP);
     int usable_count = 0;
     for (int i = 0; i < native_count; i++) {
         const int n = i + 1;
@@ -4587,7 +4654,7 @@ _SOKOL_PRIVATE int _sapp_wgl_find_pixel_format(void) {
     if (closest) {
         pixel_format = (int) closest->handle;
     }
-    SOKOL_FREE(usable_configs);
+    _sapp_free(usable_configs, SAPP_ALLOCCATEGORY_TEMP);
     return pixel_format;
 }
 
@@ -5171,6 +5238,7 @@ _SOKOL_PRIVATE char** _sapp_win32_command_line_to_utf8_argv(LPWSTR w_command_lin
         _sapp_fail("Win32: failed to parse command line");
     } else {
         size_t size = wcslen(w_command_line) * 4;
+        /* called before sokol_main(), so sapp_desc.allocator isn't known yet */
         argv = (char**) SOKOL_CALLOC(1, (argc + 1) * sizeof(char*) + size);
         args = (char*)&argv[argc + 1];
         int n;
@@ -6227,13 +6295,16 @@ namespace /* Empty namespace to ensure internal linkage (same as _SOKOL_PRIVATE)
         // aware that a deferral may not be held indefinitely. After about five seconds,
         // the app will be forced to exit.
         auto deferral = args.SuspendingOperation().GetDeferral();
+
+        // Notify the app on the UI thread (which also renders), before the
+        // device is trimmed, so it can release GPU resources it doesn't need
+        // while suspended (e.g. with sg_evict_images(0)).
+        _sapp_win32_uwp_app_event(SAPP_EVENTTYPE_SUSPENDED);
+
         concurrency::create_task([this, deferral]()
             {
                 m_deviceResources->Trim();
 
-                // Insert your code here.
-                _sapp_win32_uwp_app_event(SAPP_EVENTTYPE_SUSPENDED);
-
                 deferral.Complete();
             });
     }
@@ -8058,7 +8129,7 @@ _SOKOL_PRIVATE GLXFBConfig _sapp_glx_choosefbconfig() {
         _sapp_fail("GLX: No GLXFBConfigs returned");
     }
 
-    usable_configs = (_sapp_gl_fbconfig*) SOKOL_CALLOC(native_count, sizeof(_sapp_gl_fbconfig));
+    usable_configs = (_sapp_gl_fbconfig*) _sapp_calloc((size_t)native_count, sizeof(_sapp_gl_fbconfig), SAPP_ALLOCCATEGORY_TEMP);
     usable_count = 0;
     for (i = 0;  i < native_count;  i++) {
         const GLXFBConfig n = native_configs[i];
@@ -8106,7 +8177,7 @@ _SOKOL_PRIVATE GLXFBConfig _sapp_glx_choosefbconfig() {
         result = (GLXFBConfig) closest->handle;
     }
     XFree(native_configs);
-    SOKOL_FREE(usable_configs);
+    _sapp_free(usable_configs, SAPP_ALLOCCATEGORY_TEMP);
     return result;
 }
 
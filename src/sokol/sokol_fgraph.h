@@ -0,0 +1,872 @@
+#ifndef SOKOL_FGRAPH_INCLUDED
+/*
+    sokol_fgraph.h -- a frame graph with transient render targets on top of sokol_gfx.h
+
+    Project URL: https://github.com/Aftnet/sokol_app_uwp
+
+    Do this:
+        #define SOKOL_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_LOG(msg)      - your own logging function (default: puts(msg))
+    SOKOL_API_DECL      - public function declaration prefix (default: extern)
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_fgraph.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    Include the following headers before including sokol_fgraph.h:
+
+        sokol_gfx.h
+
+    OVERVIEW
+    ========
+    Offscreen render passes need render target images and sg_pass objects,
+    usually those are created upfront and live for the whole application,
+    even when they are only needed for a small part of a frame.
+
+    sokol_fgraph.h replaces those hand-made render targets with a frame
+    graph which is rebuilt each frame:
+
+    - render passes declare which render targets they write (the pass
+      attachments) and which they read (as textures)
+    - passes which don't contribute to the final output are culled
+    - the remaining passes are sorted so that each pass runs after the
+      passes it depends on
+    - transient render targets are allocated from a pool of sg_image
+      objects, the same image is reused by several render targets if
+      their lifetimes in the frame don't overlap, this reduces the
+      render target memory of a chain of post-processing passes to
+      (usually) two images
+    - the content of a transient render target is discarded after the
+      last pass which uses it (see sg_store_action)
+
+    STEP BY STEP
+    ============
+    --- call sfg_setup() after sg_setup():
+
+            sfg_setup(&(sfg_desc){0});
+
+        Optionally override the following sfg_desc items:
+
+            .max_passes         - max number of passes per frame (default: 32)
+            .max_resources      - max number of resources per frame (default: 64)
+            .image_pool_size    - max number of pooled images (default: 32)
+            .pass_pool_size     - max number of pooled sg_pass objects (default: 32)
+            .max_idle_frames    - pooled images and passes which haven't been
+                                  used for this number of frames will be
+                                  destroyed (default: 4)
+
+    --- each frame, start a new frame graph:
+
+            sfg_begin();
+
+    --- declare transient render targets, these are only valid for the
+        current frame:
+
+            sfg_resource scene = sfg_create_texture(&(sfg_texture_desc){
+                .width = w,
+                .height = h,
+                .pixel_format = ...,     (default: sg_desc.context.color_format)
+                .sample_count = ...,     (default: 1)
+                .min_filter, .mag_filter, .wrap_u, .wrap_v, .label
+            });
+
+        ...or make persistent images known to the frame graph, passes
+        which render into imported images are never culled:
+
+            sfg_resource res = sfg_import_image(img);
+
+    --- add render passes, the pass callback is called between
+        sg_begin_pass() and sg_end_pass() when the pass is executed:
+
+            sfg_add_pass(&(sfg_pass_desc){
+                .color_attachments[0] = bloom,
+                .reads[0] = scene,
+                .action = { ... },
+                .exec_cb = draw_bloom,
+                .user_data = ...
+            });
+
+        For a pass which renders into the default framebuffer, set
+        .default_pass to true and provide .width and .height instead
+        of the attachments. Default passes and passes with .side_effects
+        set to true are never culled.
+
+    --- in the pass callbacks, call sfg_image() to get the sg_image of
+        a resource (for instance to bind it as texture):
+
+            bind.fs_images[0] = sfg_image(scene);
+
+    --- finally, compile and execute the frame graph:
+
+            sfg_execute();
+
+        This must happen outside of sg_begin_pass()/sg_end_pass() and
+        before sg_commit().
+
+    --- call sfg_shutdown() before sg_shutdown() to destroy the pooled
+        images and passes.
+
+    RULES FOR READING AND WRITING
+    =============================
+    All passes which write a resource run before the passes which only
+    read the resource. If more than one pass writes the same resource, they
+    run in the order they have been added, and all passes but the first
+    should load the previous content (SG_ACTION_LOAD). A pass attachment
+    with SG_ACTION_LOAD counts as a read too. It's not possible to
+    'ping-pong' between writing and reading the same resource, instead
+    create a new transient resource, this doesn't cost extra memory
+    because the images are aliased anyway.
+
+    Dependency cycles are detected, and the passes are then executed
+    in the order they have been added.
+
+    The pass action's store actions default to SG_STOREACTION_DONTCARE for
+    transient attachments which aren't used after the pass.
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) the sokol_app_uwp contributors
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_FGRAPH_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_fgraph.h"
+#endif
+
+#ifndef SOKOL_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_IMPL)
+#define SOKOL_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* a render target in the current frame graph */
+typedef struct sfg_resource { uint32_t id; } sfg_resource;
+
+enum {
+    SFG_INVALID_ID = 0,
+    SFG_MAX_PASS_READS = 8,
+};
+
+typedef struct sfg_texture_desc {
+    int width;
+    int height;
+    sg_pixel_format pixel_format;
+    int sample_count;
+    sg_filter min_filter;
+    sg_filter mag_filter;
+    sg_wrap wrap_u;
+    sg_wrap wrap_v;
+    const char* label;
+} sfg_texture_desc;
+
+typedef struct sfg_pass_desc {
+    sfg_resource color_attachments[SG_MAX_COLOR_ATTACHMENTS];
+    sfg_resource depth_stencil_attachment;
+    sfg_resource reads[SFG_MAX_PASS_READS];
+    sg_pass_action action;
+    bool default_pass;      /* render into the default framebuffer */
+    int width;              /* only for default passes */
+    int height;
+    bool side_effects;      /* never cull this pass */
+    void (*exec_cb)(void* user_data);
+    void* user_data;
+    const char* label;
+} sfg_pass_desc;
+
+typedef struct sfg_desc {
+    int max_passes;
+    int max_resources;
+    int image_pool_size;
+    int pass_pool_size;
+    int max_idle_frames;
+} sfg_desc;
+
+/* statistics of the last executed frame graph */
+typedef struct sfg_frame_stats {
+    int num_passes;             /* number of passes added to the frame graph */
+    int num_culled_passes;      /* number of passes which have not been executed */
+    int num_transient_textures; /* number of transient textures created in the frame */
+    int num_images;             /* number of pooled images used in the frame */
+    int num_pool_images;        /* number of pooled images alive */
+    int num_pool_passes;        /* number of pooled sg_pass objects alive */
+} sfg_frame_stats;
+
+SOKOL_API_DECL void sfg_setup(const sfg_desc* desc);
+SOKOL_API_DECL void sfg_shutdown(void);
+SOKOL_API_DECL void sfg_begin(void);
+SOKOL_API_DECL sfg_resource sfg_create_texture(const sfg_texture_desc* desc);
+SOKOL_API_DECL sfg_resource sfg_import_image(sg_image img);
+SOKOL_API_DECL void sfg_add_pass(const sfg_pass_desc* desc);
+SOKOL_API_DECL void sfg_execute(void);
+SOKOL_API_DECL sg_image sfg_image(sfg_resource res);
+SOKOL_API_DECL sfg_frame_stats sfg_query_frame_stats(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* SOKOL_FGRAPH_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_IMPL
+#define SOKOL_FGRAPH_IMPL_INCLUDED (1)
+#include <string.h> /* memset, memcmp */
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef SOKOL_LOG
+    #ifdef SOKOL_DEBUG
+        #include <stdio.h>
+        #define SOKOL_LOG(s) { SOKOL_ASSERT(s); puts(s); }
+    #else
+        #define SOKOL_LOG(s)
+    #endif
+#endif
+
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _sfg_def(val, def) (((val) == 0) ? (def) : (val))
+
+/* dependency flags between two passes */
+#define _SFG_DEP_ORDER (1)  /* must run after the other pass */
+#define _SFG_DEP_DATA (2)   /* reads the output of the other pass */
+
+typedef struct {
+    sfg_texture_desc desc;  /* only for transient resources */
+    sg_image img;           /* the imported image, or the pooled image assigned in sfg_execute() */
+    bool imported;
+    int first_use;          /* first and last execution step using the resource, -1 if unused */
+    int last_use;
+} _sfg_resource_t;
+
+typedef struct {
+    sfg_pass_desc desc;
+    bool live;
+} _sfg_pass_t;
+
+typedef struct {
+    sfg_texture_desc desc;  /* with defaults resolved, and without label */
+    sg_image img;           /* SG_INVALID_ID if the pool slot is free */
+    int busy_until;         /* last execution step the image is used in the current frame, or -1 */
+    uint32_t used_frame;
+} _sfg_pool_image_t;
+
+typedef struct {
+    uint32_t color_img_ids[SG_MAX_COLOR_ATTACHMENTS];
+    uint32_t ds_img_id;
+    sg_pass pass;           /* SG_INVALID_ID if the pool slot is free */
+    uint32_t used_frame;
+} _sfg_pool_pass_t;
+
+typedef struct {
+    bool valid;
+    bool in_frame;
+    sfg_desc desc;
+    sg_pixel_format default_color_format;
+    uint32_t frame_index;
+    int num_passes;
+    int num_resources;
+    _sfg_pass_t* passes;
+    _sfg_resource_t* resources;
+    uint8_t* deps;          /* deps[i * max_passes + j]: dependency flags of pass j on pass i */
+    int* order;             /* pass indices sorted by dependencies */
+    int* steps;             /* pass indices of the live passes in execution order */
+    int num_steps;
+    _sfg_pool_image_t* images;
+    _sfg_pool_pass_t* pool_passes;
+    sfg_frame_stats stats;
+} _sfg_state_t;
+static _sfg_state_t _sfg;
+
+/*== PRIVATE FUNCTIONS =======================================================*/
+_SOKOL_PRIVATE int _sfg_resource_index(sfg_resource res) {
+    if (SFG_INVALID_ID == res.id) {
+        return -1;
+    }
+    int index = (int)res.id - 1;
+    SOKOL_ASSERT((index >= 0) && (index < _sfg.num_resources));
+    return index;
+}
+
+_SOKOL_PRIVATE bool _sfg_pass_writes(const sfg_pass_desc* pass, int res_index) {
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        if (_sfg_resource_index(pass->color_attachments[i]) == res_index) {
+            return true;
+        }
+    }
+    return _sfg_resource_index(pass->depth_stencil_attachment) == res_index;
+}
+
+/* attachments which load their previous content count as reads */
+_SOKOL_PRIVATE bool _sfg_pass_reads(const sfg_pass_desc* pass, int res_index) {
+    for (int i = 0; i < SFG_MAX_PASS_READS; i++) {
+        if (_sfg_resource_index(pass->reads[i]) == res_index) {
+            return true;
+        }
+    }
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        if ((_sfg_resource_index(pass->color_attachments[i]) == res_index) &&
+            (SG_ACTION_LOAD == pass->action.colors[i].action))
+        {
+            return true;
+        }
+    }
+    if (_sfg_resource_index(pass->depth_stencil_attachment) == res_index) {
+        return (SG_ACTION_LOAD == pass->action.depth.action) || (SG_ACTION_LOAD == pass->action.stencil.action);
+    }
+    return false;
+}
+
+_SOKOL_PRIVATE bool _sfg_pass_is_root(const sfg_pass_desc* pass) {
+    if (pass->default_pass || pass->side_effects) {
+        return true;
+    }
+    for (int i = 0; i < _sfg.num_resources; i++) {
+        if (_sfg.resources[i].imported && _sfg_pass_writes(pass, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+_SOKOL_PRIVATE uint8_t* _sfg_dep(int from_pass, int to_pass) {
+    return &_sfg.deps[from_pass * _sfg.desc.max_passes + to_pass];
+}
+
+/* build the dependency flags between all passes of the frame */
+_SOKOL_PRIVATE void _sfg_build_deps(void) {
+    memset(_sfg.deps, 0, (size_t)(_sfg.desc.max_passes * _sfg.desc.max_passes));
+    for (int r = 0; r < _sfg.num_resources; r++) {
+        for (int i = 0; i < _sfg.num_passes; i++) {
+            if (!_sfg_pass_writes(&_sfg.passes[i].desc, r)) {
+                continue;
+            }
+            for (int j = 0; j < _sfg.num_passes; j++) {
+                if (i == j) {
+                    continue;
+                }
+                const bool j_writes = _sfg_pass_writes(&_sfg.passes[j].desc, r);
+                const bool j_reads = _sfg_pass_reads(&_sfg.passes[j].desc, r);
+                if (j_writes) {
+                    /* several writers run in the order they have been added */
+                    if (i < j) {
+                        *_sfg_dep(i, j) |= _SFG_DEP_ORDER | (j_reads ? _SFG_DEP_DATA : 0);
+                    }
+                }
+                else if (j_reads) {
+                    *_sfg_dep(i, j) |= _SFG_DEP_ORDER | _SFG_DEP_DATA;
+                }
+            }
+        }
+    }
+}
+
+/* topological sort of all passes, prefers the order the passes have been added in */
+_SOKOL_PRIVATE bool _sfg_sort_passes(void) {
+    /* use the steps array as scratch space for the number of unresolved dependencies */
+    int* num_deps = _sfg.steps;
+    for (int j = 0; j < _sfg.num_passes; j++) {
+        num_deps[j] = 0;
+        for (int i = 0; i < _sfg.num_passes; i++) {
+            if (*_sfg_dep(i, j) & _SFG_DEP_ORDER) {
+                num_deps[j]++;
+            }
+        }
+    }
+    for (int n = 0; n < _sfg.num_passes; n++) {
+        int next = -1;
+        for (int j = 0; j < _sfg.num_passes; j++) {
+            if (0 == num_deps[j]) {
+                next = j;
+                break;
+            }
+        }
+        if (next < 0) {
+            return false;
+        }
+        _sfg.order[n] = next;
+        num_deps[next] = -1;
+        for (int j = 0; j < _sfg.num_passes; j++) {
+            if (*_sfg_dep(next, j) & _SFG_DEP_ORDER) {
+                num_deps[j]--;
+            }
+        }
+    }
+    return true;
+}
+
+/* a pass is alive if it's a root, or a live pass reads its output */
+_SOKOL_PRIVATE void _sfg_cull_passes(void) {
+    for (int n = _sfg.num_passes - 1; n >= 0; n--) {
+        const int i = _sfg.order[n];
+        _sfg_pass_t* pass = &_sfg.passes[i];
+        pass->live = _sfg_pass_is_root(&pass->desc);
+        for (int j = 0; (j < _sfg.num_passes) && !pass->live; j++) {
+            if (_sfg.passes[j].live && (*_sfg_dep(i, j) & _SFG_DEP_DATA)) {
+                pass->live = true;
+            }
+        }
+    }
+    _sfg.num_steps = 0;
+    for (int n = 0; n < _sfg.num_passes; n++) {
+        const int i = _sfg.order[n];
+        if (_sfg.passes[i].live) {
+            _sfg.steps[_sfg.num_steps++] = i;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sfg_use_resource(sfg_resource res, int step) {
+    const int index = _sfg_resource_index(res);
+    if (index >= 0) {
+        _sfg_resource_t* r = &_sfg.resources[index];
+        if ((r->first_use < 0) || (step < r->first_use)) {
+            r->first_use = step;
+        }
+        if (step > r->last_use) {
+            r->last_use = step;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sfg_compute_lifetimes(void) {
+    for (int i = 0; i < _sfg.num_resources; i++) {
+        _sfg.resources[i].first_use = -1;
+        _sfg.resources[i].last_use = -1;
+    }
+    for (int s = 0; s < _sfg.num_steps; s++) {
+        const sfg_pass_desc* pass = &_sfg.passes[_sfg.steps[s]].desc;
+        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+            _sfg_use_resource(pass->color_attachments[i], s);
+        }
+        _sfg_use_resource(pass->depth_stencil_attachment, s);
+        for (int i = 0; i < SFG_MAX_PASS_READS; i++) {
+            _sfg_use_resource(pass->reads[i], s);
+        }
+    }
+}
+
+_SOKOL_PRIVATE bool _sfg_texture_desc_equal(const sfg_texture_desc* a, const sfg_texture_desc* b) {
+    return (a->width == b->width) &&
+           (a->height == b->height) &&
+           (a->pixel_format == b->pixel_format) &&
+           (a->sample_count == b->sample_count) &&
+           (a->min_filter == b->min_filter) &&
+           (a->mag_filter == b->mag_filter) &&
+           (a->wrap_u == b->wrap_u) &&
+           (a->wrap_v == b->wrap_v);
+}
+
+/* find a pooled image which is free at the given execution step, or create a new one */
+_SOKOL_PRIVATE int _sfg_alloc_image(const sfg_texture_desc* desc, int step) {
+    int free_slot = -1;
+    for (int i = 0; i < _sfg.desc.image_pool_size; i++) {
+        _sfg_pool_image_t* pimg = &_sfg.images[i];
+        if (SG_INVALID_ID == pimg->img.id) {
+            if (free_slot < 0) {
+                free_slot = i;
+            }
+        }
+        else if ((pimg->busy_until < step) && _sfg_texture_desc_equal(&pimg->desc, desc)) {
+            return i;
+        }
+    }
+    if (free_slot < 0) {
+        SOKOL_LOG("sokol_fgraph.h: image pool exhausted (increase sfg_desc.image_pool_size)");
+        return -1;
+    }
+    _sfg_pool_image_t* pimg = &_sfg.images[free_slot];
+    pimg->desc = *desc;
+    pimg->desc.label = 0;
+    pimg->busy_until = -1;
+    sg_image_desc img_desc;
+    memset(&img_desc, 0, sizeof(img_desc));
+    img_desc.render_target = true;
+    img_desc.width = desc->width;
+    img_desc.height = desc->height;
+    img_desc.pixel_format = desc->pixel_format;
+    img_desc.sample_count = desc->sample_count;
+    img_desc.min_filter = desc->min_filter;
+    img_desc.mag_filter = desc->mag_filter;
+    img_desc.wrap_u = desc->wrap_u;
+    img_desc.wrap_v = desc->wrap_v;
+    img_desc.label = desc->label;
+    pimg->img = sg_make_image(&img_desc);
+    return free_slot;
+}
+
+/* assign pooled images to the transient resources, images are shared between
+   resources which are not used in the same execution steps
+*/
+_SOKOL_PRIVATE void _sfg_alloc_images(void) {
+    for (int i = 0; i < _sfg.desc.image_pool_size; i++) {
+        _sfg.images[i].busy_until = -1;
+    }
+    for (int s = 0; s < _sfg.num_steps; s++) {
+        for (int i = 0; i < _sfg.num_resources; i++) {
+            _sfg_resource_t* r = &_sfg.resources[i];
+            if (r->imported || (r->first_use != s)) {
+                continue;
+            }
+            const int pool_index = _sfg_alloc_image(&r->desc, s);
+            if (pool_index >= 0) {
+                _sfg_pool_image_t* pimg = &_sfg.images[pool_index];
+                if (pimg->busy_until < 0) {
+                    _sfg.stats.num_images++;
+                }
+                pimg->busy_until = r->last_use;
+                pimg->used_frame = _sfg.frame_index;
+                r->img = pimg->img;
+            }
+        }
+    }
+}
+
+/* find or create the sg_pass object for the attachments of a pass */
+_SOKOL_PRIVATE sg_pass _sfg_lookup_pass(const sfg_pass_desc* desc) {
+    sg_pass_desc pass_desc;
+    memset(&pass_desc, 0, sizeof(pass_desc));
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        pass_desc.color_attachments[i].image = sfg_image(desc->color_attachments[i]);
+    }
+    pass_desc.depth_stencil_attachment.image = sfg_image(desc->depth_stencil_attachment);
+    pass_desc.label = desc->label;
+
+    int free_slot = -1;
+    for (int i = 0; i < _sfg.desc.pass_pool_size; i++) {
+        _sfg_pool_pass_t* ppass = &_sfg.pool_passes[i];
+        if (SG_INVALID_ID == ppass->pass.id) {
+            if (free_slot < 0) {
+                free_slot = i;
+            }
+            continue;
+        }
+        bool match = (ppass->ds_img_id == pass_desc.depth_stencil_attachment.image.id);
+        for (int att = 0; match && (att < SG_MAX_COLOR_ATTACHMENTS); att++) {
+            match = (ppass->color_img_ids[att] == pass_desc.color_attachments[att].image.id);
+        }
+        if (match) {
+            ppass->used_frame = _sfg.frame_index;
+            return ppass->pass;
+        }
+    }
+    if (free_slot < 0) {
+        SOKOL_LOG("sokol_fgraph.h: pass pool exhausted (increase sfg_desc.pass_pool_size)");
+        sg_pass invalid = { SG_INVALID_ID };
+        return invalid;
+    }
+    _sfg_pool_pass_t* ppass = &_sfg.pool_passes[free_slot];
+    for (int att = 0; att < SG_MAX_COLOR_ATTACHMENTS; att++) {
+        ppass->color_img_ids[att] = pass_desc.color_attachments[att].image.id;
+    }
+    ppass->ds_img_id = pass_desc.depth_stencil_attachment.image.id;
+    ppass->used_frame = _sfg.frame_index;
+    ppass->pass = sg_make_pass(&pass_desc);
+    return ppass->pass;
+}
+
+/* transient attachments which are not used after the pass don't need to be stored */
+_SOKOL_PRIVATE bool _sfg_is_dead_after(sfg_resource res, int step) {
+    const int index = _sfg_resource_index(res);
+    SOKOL_ASSERT(index >= 0);
+    const _sfg_resource_t* r = &_sfg.resources[index];
+    return !r->imported && (r->last_use == step);
+}
+
+_SOKOL_PRIVATE void _sfg_resolve_store_actions(const sfg_pass_desc* desc, int step, sg_pass_action* action) {
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        if ((SFG_INVALID_ID != desc->color_attachments[i].id) &&
+            (0 == action->colors[i].store_action) &&
+            _sfg_is_dead_after(desc->color_attachments[i], step))
+        {
+            action->colors[i].store_action = SG_STOREACTION_DONTCARE;
+        }
+    }
+    if ((SFG_INVALID_ID != desc->depth_stencil_attachment.id) &&
+        _sfg_is_dead_after(desc->depth_stencil_attachment, step))
+    {
+        action->depth.store_action = _sfg_def(action->depth.store_action, SG_STOREACTION_DONTCARE);
+        action->stencil.store_action = _sfg_def(action->stencil.store_action, SG_STOREACTION_DONTCARE);
+    }
+}
+
+_SOKOL_PRIVATE void _sfg_execute_pass(const sfg_pass_desc* desc, int step) {
+    sg_pass_action action = desc->action;
+    if (desc->label) {
+        sg_push_debug_group(desc->label);
+    }
+    if (desc->default_pass) {
+        sg_begin_default_pass(&action, desc->width, desc->height);
+    }
+    else {
+        _sfg_resolve_store_actions(desc, step, &action);
+        sg_begin_pass(_sfg_lookup_pass(desc), &action);
+    }
+    if (desc->exec_cb) {
+        desc->exec_cb(desc->user_data);
+    }
+    sg_end_pass();
+    if (desc->label) {
+        sg_pop_debug_group();
+    }
+}
+
+/* destroy pooled passes and images which haven't been used for a while */
+_SOKOL_PRIVATE void _sfg_garbage_collect(void) {
+    const uint32_t max_idle = (uint32_t)_sfg.desc.max_idle_frames;
+    for (int i = 0; i < _sfg.desc.image_pool_size; i++) {
+        _sfg_pool_image_t* pimg = &_sfg.images[i];
+        if ((SG_INVALID_ID != pimg->img.id) && ((_sfg.frame_index - pimg->used_frame) > max_idle)) {
+            /* passes which use the image must go as well */
+            for (int p = 0; p < _sfg.desc.pass_pool_size; p++) {
+                _sfg_pool_pass_t* ppass = &_sfg.pool_passes[p];
+                bool uses_img = (ppass->ds_img_id == pimg->img.id);
+                for (int att = 0; att < SG_MAX_COLOR_ATTACHMENTS; att++) {
+                    uses_img |= (ppass->color_img_ids[att] == pimg->img.id);
+                }
+                if ((SG_INVALID_ID != ppass->pass.id) && uses_img) {
+                    sg_destroy_pass(ppass->pass);
+                    memset(ppass, 0, sizeof(_sfg_pool_pass_t));
+                }
+            }
+            sg_destroy_image(pimg->img);
+            memset(pimg, 0, sizeof(_sfg_pool_image_t));
+        }
+    }
+    for (int i = 0; i < _sfg.desc.pass_pool_size; i++) {
+        _sfg_pool_pass_t* ppass = &_sfg.pool_passes[i];
+        if ((SG_INVALID_ID != ppass->pass.id) && ((_sfg.frame_index - ppass->used_frame) > max_idle)) {
+            sg_destroy_pass(ppass->pass);
+            memset(ppass, 0, sizeof(_sfg_pool_pass_t));
+        }
+    }
+}
+
+/*== PUBLIC FUNCTIONS ========================================================*/
+SOKOL_API_IMPL void sfg_setup(const sfg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(sg_isvalid());
+    memset(&_sfg, 0, sizeof(_sfg));
+    _sfg.desc = *desc;
+    _sfg.desc.max_passes = _sfg_def(_sfg.desc.max_passes, 32);
+    _sfg.desc.max_resources = _sfg_def(_sfg.desc.max_resources, 64);
+    _sfg.desc.image_pool_size = _sfg_def(_sfg.desc.image_pool_size, 32);
+    _sfg.desc.pass_pool_size = _sfg_def(_sfg.desc.pass_pool_size, 32);
+    _sfg.desc.max_idle_frames = _sfg_def(_sfg.desc.max_idle_frames, 4);
+    _sfg.default_color_format = _sfg_def(sg_query_desc().context.color_format, SG_PIXELFORMAT_RGBA8);
+
+    const int max_passes = _sfg.desc.max_passes;
+    _sfg.passes = (_sfg_pass_t*) SOKOL_MALLOC(sizeof(_sfg_pass_t) * (size_t)max_passes);
+    _sfg.resources = (_sfg_resource_t*) SOKOL_MALLOC(sizeof(_sfg_resource_t) * (size_t)_sfg.desc.max_resources);
+    _sfg.deps = (uint8_t*) SOKOL_MALLOC((size_t)(max_passes * max_passes));
+    _sfg.order = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)max_passes);
+    _sfg.steps = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)max_passes);
+    const size_t images_size = sizeof(_sfg_pool_image_t) * (size_t)_sfg.desc.image_pool_size;
+    _sfg.images = (_sfg_pool_image_t*) SOKOL_MALLOC(images_size);
+    memset(_sfg.images, 0, images_size);
+    const size_t pool_passes_size = sizeof(_sfg_pool_pass_t) * (size_t)_sfg.desc.pass_pool_size;
+    _sfg.pool_passes = (_sfg_pool_pass_t*) SOKOL_MALLOC(pool_passes_size);
+    memset(_sfg.pool_passes, 0, pool_passes_size);
+    _sfg.valid = true;
+}
+
+SOKOL_API_IMPL void sfg_shutdown(void) {
+    SOKOL_ASSERT(_sfg.valid && !_sfg.in_frame);
+    for (int i = 0; i < _sfg.desc.pass_pool_size; i++) {
+        if (SG_INVALID_ID != _sfg.pool_passes[i].pass.id) {
+            sg_destroy_pass(_sfg.pool_passes[i].pass);
+        }
+    }
+    for (int i = 0; i < _sfg.desc.image_pool_size; i++) {
+        if (SG_INVALID_ID != _sfg.images[i].img.id) {
+            sg_destroy_image(_sfg.images[i].img);
+        }
+    }
+    SOKOL_FREE(_sfg.pool_passes);
+    SOKOL_FREE(_sfg.images);
+    SOKOL_FREE(_sfg.steps);
+    SOKOL_FREE(_sfg.order);
+    SOKOL_FREE(_sfg.deps);
+    SOKOL_FREE(_sfg.resources);
+    SOKOL_FREE(_sfg.passes);
+    _sfg.valid = false;
+}
+
+SOKOL_API_IMPL void sfg_begin(void) {
+    SOKOL_ASSERT(_sfg.valid && !_sfg.in_frame);
+    _sfg.in_frame = true;
+    _sfg.frame_index++;
+    _sfg.num_passes = 0;
+    _sfg.num_resources = 0;
+    _sfg.num_steps = 0;
+}
+
+SOKOL_API_IMPL sfg_resource sfg_create_texture(const sfg_texture_desc* desc) {
+    SOKOL_ASSERT(_sfg.valid && _sfg.in_frame);
+    SOKOL_ASSERT(desc && (desc->width > 0) && (desc->height > 0));
+    sfg_resource res = { SFG_INVALID_ID };
+    if (_sfg.num_resources >= _sfg.desc.max_resources) {
+        SOKOL_LOG("sokol_fgraph.h: too many resources (increase sfg_desc.max_resources)");
+        return res;
+    }
+    _sfg_resource_t* r = &_sfg.resources[_sfg.num_resources++];
+    memset(r, 0, sizeof(_sfg_resource_t));
+    r->desc = *desc;
+    r->desc.pixel_format = _sfg_def(desc->pixel_format, _sfg.default_color_format);
+    r->desc.sample_count = _sfg_def(desc->sample_count, 1);
+    r->desc.min_filter = _sfg_def(desc->min_filter, SG_FILTER_NEAREST);
+    r->desc.mag_filter = _sfg_def(desc->mag_filter, SG_FILTER_NEAREST);
+    r->desc.wrap_u = _sfg_def(desc->wrap_u, SG_WRAP_REPEAT);
+    r->desc.wrap_v = _sfg_def(desc->wrap_v, SG_WRAP_REPEAT);
+    res.id = (uint32_t)_sfg.num_resources;
+    return res;
+}
+
+SOKOL_API_IMPL sfg_resource sfg_import_image(sg_image img) {
+    SOKOL_ASSERT(_sfg.valid && _sfg.in_frame);
+    SOKOL_ASSERT(SG_INVALID_ID != img.id);
+    sfg_resource res = { SFG_INVALID_ID };
+    if (_sfg.num_resources >= _sfg.desc.max_resources) {
+        SOKOL_LOG("sokol_fgraph.h: too many resources (increase sfg_desc.max_resources)");
+        return res;
+    }
+    _sfg_resource_t* r = &_sfg.resources[_sfg.num_resources++];
+    memset(r, 0, sizeof(_sfg_resource_t));
+    r->img = img;
+    r->imported = true;
+    res.id = (uint32_t)_sfg.num_resources;
+    return res;
+}
+
+SOKOL_API_IMPL void sfg_add_pass(const sfg_pass_desc* desc) {
+    SOKOL_ASSERT(_sfg.valid && _sfg.in_frame);
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(desc->default_pass || (SFG_INVALID_ID != desc->color_attachments[0].id));
+    SOKOL_ASSERT(!desc->default_pass || ((desc->width > 0) && (desc->height > 0)));
+    if (_sfg.num_passes >= _sfg.desc.max_passes) {
+        SOKOL_LOG("sokol_fgraph.h: too many passes (increase sfg_desc.max_passes)");
+        return;
+    }
+    _sfg_pass_t* pass = &_sfg.passes[_sfg.num_passes++];
+    memset(pass, 0, sizeof(_sfg_pass_t));
+    pass->desc = *desc;
+}
+
+SOKOL_API_IMPL void sfg_execute(void) {
+    SOKOL_ASSERT(_sfg.valid && _sfg.in_frame);
+    memset(&_sfg.stats, 0, sizeof(_sfg.stats));
+    _sfg_build_deps();
+    if (!_sfg_sort_passes()) {
+        SOKOL_LOG("sokol_fgraph.h: dependency cycle in frame graph, executing passes in submission order");
+        for (int i = 0; i < _sfg.num_passes; i++) {
+            _sfg.order[i] = i;
+        }
+    }
+    _sfg_cull_passes();
+    _sfg_compute_lifetimes();
+    _sfg_alloc_images();
+    for (int s = 0; s < _sfg.num_steps; s++) {
+        _sfg_execute_pass(&_sfg.passes[_sfg.steps[s]].desc, s);
+    }
+    _sfg_garbage_collect();
+
+    _sfg.stats.num_passes = _sfg.num_passes;
+    _sfg.stats.num_culled_passes = _sfg.num_passes - _sfg.num_steps;
+    for (int i = 0; i < _sfg.num_resources; i++) {
+        if (!_sfg.resources[i].imported) {
+            _sfg.stats.num_transient_textures++;
+        }
+    }
+    for (int i = 0; i < _sfg.desc.image_pool_size; i++) {
+        if (SG_INVALID_ID != _sfg.images[i].img.id) {
+            _sfg.stats.num_pool_images++;
+        }
+    }
+    for (int i = 0; i < _sfg.desc.pass_pool_size; i++) {
+        if (SG_INVALID_ID != _sfg.pool_passes[i].pass.id) {
+            _sfg.stats.num_pool_passes++;
+        }
+    }
+    _sfg.in_frame = false;
+}
+
+SOKOL_API_IMPL sg_image sfg_image(sfg_resource res) {
+    SOKOL_ASSERT(_sfg.valid);
+    const int index = _sfg_resource_index(res);
+    if (index < 0) {
+        sg_image invalid = { SG_INVALID_ID };
+        return invalid;
+    }
+    return _sfg.resources[index].img;
+}
+
+SOKOL_API_IMPL sfg_frame_stats sfg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sfg.valid);
+    return _sfg.stats;
+}
+
+#endif /* SOKOL_IMPL */
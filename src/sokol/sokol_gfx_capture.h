@@ -0,0 +1,1705 @@
+#ifndef SOKOL_GFX_CAPTURE_INCLUDED
+/*
+    sokol_gfx_capture.h -- record sokol_gfx.h calls into a binary capture and replay them
+
+    Project URL: https://github.com/Aftnet/sokol_app_uwp
+
+    Do this:
+        #define SOKOL_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_LOG(msg)      - your own logging function (default: puts(msg))
+    SOKOL_API_DECL      - public function declaration prefix (default: extern)
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_gfx_capture.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    Include the following headers before including sokol_gfx_capture.h:
+
+        sokol_gfx.h
+
+    The sokol_gfx.h implementation must be compiled with SOKOL_TRACE_HOOKS
+    defined, capturing is implemented with the sokol_gfx trace hooks.
+
+    OVERVIEW
+    ========
+    sokol_gfx_capture.h serializes the sokol_gfx calls of an application
+    (resource creation with the complete resource content, resource updates,
+    passes, bindings, uniform data and draw calls) into a compact binary
+    stream, and replays such a stream on any sokol_gfx backend, including
+    the dummy backend, while measuring the CPU time spent in each call.
+
+    This allows to reproduce performance problems of a production workload
+    offline, and to benchmark changes to sokol_gfx against real captured
+    workloads. The standalone replay tool in tools/sgcap_replay.c replays
+    a capture file on the dummy backend and prints a timing report.
+
+    The capture format stores the sokol_gfx desc structs as they are in
+    memory, followed by the data their pointers point to. A capture can
+    only be replayed by a program built from the same sokol_gfx.h version
+    for the same CPU architecture, this is checked when a replay starts.
+
+    CAPTURING
+    =========
+    --- call sgcap_begin() right after sg_setup(), so that all resources
+        are seen by the capture:
+
+            sgcap_begin(&(sgcap_desc){
+                .path = "frames.sgcap"
+            });
+
+        Instead of a file path, a .write_cb callback can be provided which
+        is called with chunks of the capture stream (at least once per frame).
+
+    --- by default, all calls are recorded until sgcap_end(). With
+        .frames_on_demand = true, only resource creation, destruction and
+        updates (including sg_append_buffer() and sg_generate_mipmaps())
+        are recorded all the time, and the rendering commands only for the
+        frames requested with:
+
+            sgcap_capture_frames(int num_frames);
+
+        The recording of rendering commands starts with the next frame.
+
+    --- call sgcap_end() before sg_shutdown() to flush and close the capture,
+        this also restores the trace hooks which were installed before
+        sgcap_begin() (other trace hooks are not called while capturing).
+
+    REPLAYING
+    =========
+    The capture data must be completely loaded into memory and must remain
+    valid until sgcap_replay_end() is called.
+
+    --- get the pool sizes and backend of the capture before sg_setup(), the
+        replay needs at least the same pool sizes as the capture:
+
+            sgcap_capture_info info;
+            if (sgcap_query_capture_info(data, size, &info)) {
+                sg_setup(&(sg_desc){
+                    .buffer_pool_size = info.buffer_pool_size,
+                    ...
+                });
+            }
+
+        Shaders can only be created on the backend they were captured on,
+        or on the dummy backend. The software backend can't replay captures
+        at all, since the shader callbacks (sg_shader_desc.sw) are process
+        addresses and aren't recorded, replay those captures on the dummy
+        backend.
+
+    --- start the replay:
+
+            sgcap_replay_begin(data, size);
+
+    --- replay one captured frame (up to and including the sg_commit() of
+        the frame), this returns false at the end of the capture:
+
+            while (sgcap_replay_frame()) { }
+
+    --- get the timings, per call type and per frame:
+
+            sgcap_replay_stats stats = sgcap_query_replay_stats();
+
+    --- finally destroy all resources created by the replay:
+
+            sgcap_replay_end();
+
+    LIMITATIONS
+    ===========
+    - resources which have been created before sgcap_begin() are unknown to
+      the capture, calls using those resources fail in the replay
+    - resources injected from native 3D-API objects are created without
+      the native object in the replay
+    - the callbacks of sg_read_image_async() are not recorded, the replay
+      issues the readbacks with a callback which ignores the result
+    - rendering contexts (sg_setup_context() etc.) are not recorded
+    - the software backend shader callbacks and their user data are not
+      recorded (see REPLAYING)
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) the sokol_app_uwp contributors
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_GFX_CAPTURE_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_gfx_capture.h"
+#endif
+
+#ifndef SOKOL_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_IMPL)
+#define SOKOL_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the recorded calls */
+typedef enum sgcap_cmd {
+    SGCAP_CMD_INVALID,
+    SGCAP_CMD_MAKE_BUFFER,
+    SGCAP_CMD_MAKE_IMAGE,
+    SGCAP_CMD_MAKE_SHADER,
+    SGCAP_CMD_MAKE_PIPELINE,
+    SGCAP_CMD_MAKE_PASS,
+    SGCAP_CMD_MAKE_OCCLUSION_QUERY,
+    SGCAP_CMD_DESTROY_BUFFER,
+    SGCAP_CMD_DESTROY_IMAGE,
+    SGCAP_CMD_DESTROY_SHADER,
+    SGCAP_CMD_DESTROY_PIPELINE,
+    SGCAP_CMD_DESTROY_PASS,
+    SGCAP_CMD_DESTROY_OCCLUSION_QUERY,
+    SGCAP_CMD_UPDATE_BUFFER,
+    SGCAP_CMD_UPDATE_IMAGE,
+    SGCAP_CMD_APPEND_BUFFER,
+    SGCAP_CMD_GENERATE_MIPMAPS,
+    SGCAP_CMD_READ_IMAGE_ASYNC,
+    SGCAP_CMD_RESET_STATE_CACHE,
+    SGCAP_CMD_INVALIDATE_STATE_CACHE,
+    SGCAP_CMD_BEGIN_DEFAULT_PASS,
+    SGCAP_CMD_BEGIN_PASS,
+    SGCAP_CMD_APPLY_VIEWPORT,
+    SGCAP_CMD_APPLY_SCISSOR_RECT,
+    SGCAP_CMD_APPLY_PIPELINE,
+    SGCAP_CMD_APPLY_BINDINGS,
+    SGCAP_CMD_APPLY_UNIFORMS,
+    SGCAP_CMD_DRAW,
+    SGCAP_CMD_MULTI_DRAW,
+    SGCAP_CMD_DRAW_INDIRECT,
+    SGCAP_CMD_BEGIN_OCCLUSION_QUERY,
+    SGCAP_CMD_END_OCCLUSION_QUERY,
+    SGCAP_CMD_BEGIN_CONDITIONAL_RENDER,
+    SGCAP_CMD_END_CONDITIONAL_RENDER,
+    SGCAP_CMD_END_PASS,
+    SGCAP_CMD_BEGIN_COMPUTE_PASS,
+    SGCAP_CMD_DISPATCH,
+    SGCAP_CMD_END_COMPUTE_PASS,
+    SGCAP_CMD_PUSH_DEBUG_GROUP,
+    SGCAP_CMD_POP_DEBUG_GROUP,
+    SGCAP_CMD_COMMIT,
+    SGCAP_CMD_NUM
+} sgcap_cmd;
+
+typedef struct sgcap_desc {
+    const char* path;           /* the capture file to write, or... */
+    void (*write_cb)(const void* data, int num_bytes, void* user_data);   /* ...a callback which receives the capture stream */
+    void* user_data;
+    bool frames_on_demand;      /* only record rendering commands of frames requested with sgcap_capture_frames() */
+} sgcap_desc;
+
+/* information from the header of a capture */
+typedef struct sgcap_capture_info {
+    sg_backend backend;         /* the backend the capture was recorded on */
+    int buffer_pool_size;
+    int image_pool_size;
+    int shader_pool_size;
+    int pipeline_pool_size;
+    int pass_pool_size;
+    int occlusion_query_pool_size;
+    int num_frames;             /* number of captured frames */
+    int num_calls;              /* number of recorded calls */
+} sgcap_capture_info;
+
+/* replay timings of one call type, in nanoseconds */
+typedef struct sgcap_call_stats {
+    const char* name;
+    int num_calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} sgcap_call_stats;
+
+typedef struct sgcap_replay_stats {
+    int num_frames;             /* number of replayed frames */
+    uint64_t total_frame_ns;    /* sum of the replay time of all frames */
+    uint64_t min_frame_ns;
+    uint64_t max_frame_ns;
+    sgcap_call_stats calls[SGCAP_CMD_NUM];
+} sgcap_replay_stats;
+
+/* capturing */
+SOKOL_API_DECL bool sgcap_begin(const sgcap_desc* desc);
+SOKOL_API_DECL void sgcap_capture_frames(int num_frames);
+SOKOL_API_DECL bool sgcap_capturing(void);
+SOKOL_API_DECL void sgcap_end(void);
+
+/* replaying */
+SOKOL_API_DECL bool sgcap_query_capture_info(const void* data, int num_bytes, sgcap_capture_info* out_info);
+SOKOL_API_DECL bool sgcap_replay_begin(const void* data, int num_bytes);
+SOKOL_API_DECL bool sgcap_replay_frame(void);
+SOKOL_API_DECL sgcap_replay_stats sgcap_query_replay_stats(void);
+SOKOL_API_DECL void sgcap_replay_end(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* SOKOL_GFX_CAPTURE_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_IMPL
+#define SOKOL_GFX_CAPTURE_IMPL_INCLUDED (1)
+#include <string.h> /* memset, memcpy, strlen */
+#include <stdio.h>  /* fopen, fwrite, fclose */
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef SOKOL_LOG
+    #ifdef SOKOL_DEBUG
+        #define SOKOL_LOG(s) { SOKOL_ASSERT(s); puts(s); }
+    #else
+        #define SOKOL_LOG(s)
+    #endif
+#endif
+
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__APPLE__)
+    #include <mach/mach_time.h>
+#else
+    #include <time.h>
+#endif
+
+#define _SGCAP_MAGIC (0x50434753)   /* 'SGCP' */
+#define _SGCAP_VERSION (2)
+#define _SGCAP_SLOT_MASK (0xFFFF)   /* must match _SG_SLOT_MASK in sokol_gfx.h */
+#define _SGCAP_INITIAL_BUFFER_SIZE (64 * 1024)
+
+enum {
+    _SGCAP_RES_BUFFER,
+    _SGCAP_RES_IMAGE,
+    _SGCAP_RES_SHADER,
+    _SGCAP_RES_PIPELINE,
+    _SGCAP_RES_PASS,
+    _SGCAP_RES_OCCLUSION_QUERY,
+    _SGCAP_RES_NUM
+};
+
+/* the file header, all struct sizes must match for a replay */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t backend;
+    uint32_t pool_size[_SGCAP_RES_NUM];
+    uint32_t struct_size[11];
+} _sgcap_header_t;
+
+typedef struct {
+    bool valid;
+    sgcap_desc desc;
+    FILE* file;
+    sg_trace_hooks prev_hooks;
+    uint8_t* buf;
+    int buf_size;
+    int buf_pos;
+    int cmd_pos;            /* start of the current record */
+    int frames_left;        /* frames requested with sgcap_capture_frames() */
+    bool recording;         /* recording rendering commands in the current frame */
+} _sgcap_capture_t;
+
+typedef struct {
+    const uint8_t* ptr;
+    const uint8_t* end;
+    bool error;
+} _sgcap_reader_t;
+
+typedef struct {
+    bool valid;
+    _sgcap_reader_t reader;
+    uint32_t* ids[_SGCAP_RES_NUM];      /* replayed resource ids, indexed by the slot index of the captured id */
+    int pool_size[_SGCAP_RES_NUM];
+    bool cond_render_occluded;          /* inside a conditional render which was occluded when captured */
+    sgcap_replay_stats stats;
+} _sgcap_replay_t;
+
+typedef struct {
+    _sgcap_capture_t cap;
+    _sgcap_replay_t rep;
+} _sgcap_state_t;
+static _sgcap_state_t _sgcap;
+
+static const char* _sgcap_cmd_names[SGCAP_CMD_NUM] = {
+    "invalid",
+    "make_buffer",
+    "make_image",
+    "make_shader",
+    "make_pipeline",
+    "make_pass",
+    "make_occlusion_query",
+    "destroy_buffer",
+    "destroy_image",
+    "destroy_shader",
+    "destroy_pipeline",
+    "destroy_pass",
+    "destroy_occlusion_query",
+    "update_buffer",
+    "update_image",
+    "append_buffer",
+    "generate_mipmaps",
+    "read_image_async",
+    "reset_state_cache",
+    "invalidate_state_cache",
+    "begin_default_pass",
+    "begin_pass",
+    "apply_viewport",
+    "apply_scissor_rect",
+    "apply_pipeline",
+    "apply_bindings",
+    "apply_uniforms",
+    "draw",
+    "multi_draw",
+    "draw_indirect",
+    "begin_occlusion_query",
+    "end_occlusion_query",
+    "begin_conditional_render",
+    "end_conditional_render",
+    "end_pass",
+    "begin_compute_pass",
+    "dispatch",
+    "end_compute_pass",
+    "push_debug_group",
+    "pop_debug_group",
+    "commit",
+};
+
+/*== COMMON ==================================================================*/
+_SOKOL_PRIVATE uint64_t _sgcap_now_ns(void) {
+    #if defined(_WIN32)
+        LARGE_INTEGER freq, count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        const uint64_t secs = (uint64_t)(count.QuadPart / freq.QuadPart);
+        const uint64_t rem = (uint64_t)(count.QuadPart % freq.QuadPart);
+        return secs * 1000000000 + (rem * 1000000000) / (uint64_t)freq.QuadPart;
+    #elif defined(__APPLE__)
+        static mach_timebase_info_data_t timebase;
+        if (0 == timebase.denom) {
+            mach_timebase_info(&timebase);
+        }
+        return (mach_absolute_time() * timebase.numer) / timebase.denom;
+    #elif defined(CLOCK_MONOTONIC)
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    #elif defined(TIME_UTC)
+        /* C11 without POSIX extensions */
+        struct timespec ts;
+        timespec_get(&ts, TIME_UTC);
+        return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    #else
+        return ((uint64_t)clock() * 1000000000) / CLOCKS_PER_SEC;
+    #endif
+}
+
+/* without sg_desc, only the struct sizes are filled in */
+_SOKOL_PRIVATE void _sgcap_init_header(_sgcap_header_t* hdr, const sg_desc* desc) {
+    memset(hdr, 0, sizeof(_sgcap_header_t));
+    hdr->magic = _SGCAP_MAGIC;
+    hdr->version = _SGCAP_VERSION;
+    if (desc) {
+        hdr->backend = (uint32_t) sg_query_backend();
+        hdr->pool_size[_SGCAP_RES_BUFFER] = (uint32_t) desc->buffer_pool_size;
+        hdr->pool_size[_SGCAP_RES_IMAGE] = (uint32_t) desc->image_pool_size;
+        hdr->pool_size[_SGCAP_RES_SHADER] = (uint32_t) desc->shader_pool_size;
+        hdr->pool_size[_SGCAP_RES_PIPELINE] = (uint32_t) desc->pipeline_pool_size;
+        hdr->pool_size[_SGCAP_RES_PASS] = (uint32_t) desc->pass_pool_size;
+        hdr->pool_size[_SGCAP_RES_OCCLUSION_QUERY] = (uint32_t) desc->occlusion_query_pool_size;
+    }
+    hdr->struct_size[0] = sizeof(sg_buffer_desc);
+    hdr->struct_size[1] = sizeof(sg_image_desc);
+    hdr->struct_size[2] = sizeof(sg_shader_desc);
+    hdr->struct_size[3] = sizeof(sg_pipeline_desc);
+    hdr->struct_size[4] = sizeof(sg_pass_desc);
+    hdr->struct_size[5] = sizeof(sg_occlusion_query_desc);
+    hdr->struct_size[6] = sizeof(sg_pass_action);
+    hdr->struct_size[7] = sizeof(sg_bindings);
+    hdr->struct_size[8] = sizeof(sg_image_content);
+    hdr->struct_size[9] = sizeof(sg_dirty_state);
+    hdr->struct_size[10] = sizeof(sg_draw_item);
+}
+
+/*== CAPTURE =================================================================*/
+_SOKOL_PRIVATE void _sgcap_flush(void) {
+    if (_sgcap.cap.buf_pos > 0) {
+        if (_sgcap.cap.file) {
+            fwrite(_sgcap.cap.buf, 1, (size_t)_sgcap.cap.buf_pos, _sgcap.cap.file);
+        }
+        else if (_sgcap.cap.desc.write_cb) {
+            _sgcap.cap.desc.write_cb(_sgcap.cap.buf, _sgcap.cap.buf_pos, _sgcap.cap.desc.user_data);
+        }
+        _sgcap.cap.buf_pos = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_write(const void* data, int num_bytes) {
+    SOKOL_ASSERT(num_bytes >= 0);
+    if ((_sgcap.cap.buf_pos + num_bytes) > _sgcap.cap.buf_size) {
+        int new_size = _sgcap.cap.buf_size;
+        while ((_sgcap.cap.buf_pos + num_bytes) > new_size) {
+            new_size *= 2;
+        }
+        uint8_t* new_buf = (uint8_t*) SOKOL_MALLOC((size_t)new_size);
+        SOKOL_ASSERT(new_buf);
+        memcpy(new_buf, _sgcap.cap.buf, (size_t)_sgcap.cap.buf_pos);
+        SOKOL_FREE(_sgcap.cap.buf);
+        _sgcap.cap.buf = new_buf;
+        _sgcap.cap.buf_size = new_size;
+    }
+    if (num_bytes > 0) {
+        memcpy(_sgcap.cap.buf + _sgcap.cap.buf_pos, data, (size_t)num_bytes);
+        _sgcap.cap.buf_pos += num_bytes;
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_write_u32(uint32_t val) {
+    _sgcap_write(&val, sizeof(val));
+}
+
+_SOKOL_PRIVATE void _sgcap_write_int(int val) {
+    _sgcap_write(&val, sizeof(val));
+}
+
+/* the data behind a pointer is only written if the pointer isn't null,
+   the reader checks the (captured) pointer value in the struct
+*/
+_SOKOL_PRIVATE void _sgcap_write_ptr(const void* ptr, int num_bytes) {
+    if (ptr) {
+        SOKOL_ASSERT(num_bytes >= 0);
+        _sgcap_write_u32((uint32_t)num_bytes);
+        _sgcap_write(ptr, num_bytes);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_write_str(const char* str) {
+    if (str) {
+        _sgcap_write_ptr(str, (int)strlen(str) + 1);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_write_image_content(const sg_image_content* content) {
+    for (int face = 0; face < SG_CUBEFACE_NUM; face++) {
+        for (int mip = 0; mip < SG_MAX_MIPMAPS; mip++) {
+            const sg_subimage_content* sub = &content->subimage[face][mip];
+            _sgcap_write_ptr(sub->ptr, sub->size);
+        }
+    }
+}
+
+/*
+    resource creation, destruction and updates are always recorded, this
+    includes appended buffer data and generated mipmaps, otherwise the
+    recorded frames would start with the wrong resource content
+*/
+_SOKOL_PRIVATE bool _sgcap_is_resource_cmd(sgcap_cmd cmd) {
+    return (cmd >= SGCAP_CMD_MAKE_BUFFER) && (cmd <= SGCAP_CMD_GENERATE_MIPMAPS);
+}
+
+/* a record is the command, the size of the payload, and the payload */
+_SOKOL_PRIVATE bool _sgcap_begin_cmd(sgcap_cmd cmd) {
+    if (!_sgcap.cap.recording && !_sgcap_is_resource_cmd(cmd)) {
+        return false;
+    }
+    _sgcap.cap.cmd_pos = _sgcap.cap.buf_pos;
+    _sgcap_write_u32((uint32_t)cmd);
+    _sgcap_write_u32(0);
+    return true;
+}
+
+_SOKOL_PRIVATE void _sgcap_end_cmd(void) {
+    const uint32_t payload_size = (uint32_t)(_sgcap.cap.buf_pos - _sgcap.cap.cmd_pos - 8);
+    memcpy(_sgcap.cap.buf + _sgcap.cap.cmd_pos + 4, &payload_size, sizeof(payload_size));
+}
+
+_SOKOL_PRIVATE void _sgcap_id_cmd(sgcap_cmd cmd, uint32_t id) {
+    if (_sgcap_begin_cmd(cmd)) {
+        _sgcap_write_u32(id);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_noargs_cmd(sgcap_cmd cmd) {
+    if (_sgcap_begin_cmd(cmd)) {
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_make_buffer(const sg_buffer_desc* desc, sg_buffer result, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MAKE_BUFFER)) {
+        _sgcap_write_u32(result.id);
+        _sgcap_write(desc, sizeof(sg_buffer_desc));
+        _sgcap_write_ptr(desc->content, desc->size);
+        _sgcap_write_str(desc->label);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_make_image(const sg_image_desc* desc, sg_image result, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MAKE_IMAGE)) {
+        _sgcap_write_u32(result.id);
+        _sgcap_write(desc, sizeof(sg_image_desc));
+        _sgcap_write_image_content(&desc->content);
+        _sgcap_write_str(desc->label);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_write_shader_stage(const sg_shader_stage_desc* stage) {
+    _sgcap_write_str(stage->source);
+    _sgcap_write_ptr(stage->byte_code, stage->byte_code_size);
+    _sgcap_write_str(stage->entry);
+    _sgcap_write_str(stage->d3d11_target);
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+            _sgcap_write_str(stage->uniform_blocks[ub_index].uniforms[u_index].name);
+        }
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        _sgcap_write_str(stage->images[img_index].name);
+    }
+}
+
+/* function pointers and user data are only valid in the capturing process */
+_SOKOL_PRIVATE void _sgcap_clear_sw_shader(sg_sw_shader_desc* sw) {
+    sw->vs = 0;
+    sw->fs = 0;
+    sw->user_data = 0;
+}
+
+_SOKOL_PRIVATE void _sgcap_make_shader(const sg_shader_desc* desc, sg_shader result, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MAKE_SHADER)) {
+        sg_shader_desc desc_copy = *desc;
+        _sgcap_clear_sw_shader(&desc_copy.sw);
+        _sgcap_write_u32(result.id);
+        _sgcap_write(&desc_copy, sizeof(sg_shader_desc));
+        for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+            _sgcap_write_str(desc->attrs[i].name);
+            _sgcap_write_str(desc->attrs[i].sem_name);
+        }
+        _sgcap_write_shader_stage(&desc->vs);
+        _sgcap_write_shader_stage(&desc->fs);
+        _sgcap_write_shader_stage(&desc->cs);
+        _sgcap_write_str(desc->label);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_make_pipeline(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MAKE_PIPELINE)) {
+        _sgcap_write_u32(result.id);
+        _sgcap_write(desc, sizeof(sg_pipeline_desc));
+        _sgcap_write_str(desc->label);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_make_pass(const sg_pass_desc* desc, sg_pass result, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MAKE_PASS)) {
+        _sgcap_write_u32(result.id);
+        _sgcap_write(desc, sizeof(sg_pass_desc));
+        _sgcap_write_str(desc->label);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_make_occlusion_query(const sg_occlusion_query_desc* desc, sg_occlusion_query result, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MAKE_OCCLUSION_QUERY)) {
+        _sgcap_write_u32(result.id);
+        _sgcap_write(desc, sizeof(sg_occlusion_query_desc));
+        _sgcap_write_str(desc->label);
+        _sgcap_end_cmd();
+    }
+}
+
+/* resources created with sg_alloc_xxx() + sg_init_xxx() are recorded like sg_make_xxx() */
+_SOKOL_PRIVATE void _sgcap_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc, void* user_data) {
+    _sgcap_make_buffer(desc, buf_id, user_data);
+}
+
+_SOKOL_PRIVATE void _sgcap_init_image(sg_image img_id, const sg_image_desc* desc, void* user_data) {
+    _sgcap_make_image(desc, img_id, user_data);
+}
+
+_SOKOL_PRIVATE void _sgcap_init_shader(sg_shader shd_id, const sg_shader_desc* desc, void* user_data) {
+    _sgcap_make_shader(desc, shd_id, user_data);
+}
+
+_SOKOL_PRIVATE void _sgcap_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc, void* user_data) {
+    _sgcap_make_pipeline(desc, pip_id, user_data);
+}
+
+_SOKOL_PRIVATE void _sgcap_init_pass(sg_pass pass_id, const sg_pass_desc* desc, void* user_data) {
+    _sgcap_make_pass(desc, pass_id, user_data);
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy_buffer(sg_buffer buf, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_DESTROY_BUFFER, buf.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy_image(sg_image img, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_DESTROY_IMAGE, img.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy_shader(sg_shader shd, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_DESTROY_SHADER, shd.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy_pipeline(sg_pipeline pip, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_DESTROY_PIPELINE, pip.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy_pass(sg_pass pass, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_DESTROY_PASS, pass.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy_occlusion_query(sg_occlusion_query query, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_DESTROY_OCCLUSION_QUERY, query.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_update_buffer(sg_buffer buf, const void* data_ptr, int data_size, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_UPDATE_BUFFER)) {
+        _sgcap_write_u32(buf.id);
+        _sgcap_write_int(data_size);
+        _sgcap_write(data_ptr, data_size);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_update_image(sg_image img, const sg_image_content* data, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_UPDATE_IMAGE)) {
+        _sgcap_write_u32(img.id);
+        _sgcap_write(data, sizeof(sg_image_content));
+        _sgcap_write_image_content(data);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_append_buffer(sg_buffer buf, const void* data_ptr, int data_size, int result, void* user_data) {
+    (void)result; (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_APPEND_BUFFER)) {
+        _sgcap_write_u32(buf.id);
+        _sgcap_write_int(data_size);
+        _sgcap_write(data_ptr, data_size);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_generate_mipmaps(sg_image img, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_GENERATE_MIPMAPS, img.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_read_image_async(sg_image img, int x, int y, int width, int height, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_READ_IMAGE_ASYNC)) {
+        _sgcap_write_u32(img.id);
+        _sgcap_write_int(x);
+        _sgcap_write_int(y);
+        _sgcap_write_int(width);
+        _sgcap_write_int(height);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_reset_state_cache(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_RESET_STATE_CACHE);
+}
+
+_SOKOL_PRIVATE void _sgcap_invalidate_state_cache(const sg_dirty_state* dirty, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_INVALIDATE_STATE_CACHE)) {
+        _sgcap_write(dirty, sizeof(sg_dirty_state));
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_begin_default_pass(const sg_pass_action* pass_action, int width, int height, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_BEGIN_DEFAULT_PASS)) {
+        _sgcap_write(pass_action, sizeof(sg_pass_action));
+        _sgcap_write_int(width);
+        _sgcap_write_int(height);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_begin_pass(sg_pass pass, const sg_pass_action* pass_action, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_BEGIN_PASS)) {
+        _sgcap_write_u32(pass.id);
+        _sgcap_write(pass_action, sizeof(sg_pass_action));
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_rect_cmd(sgcap_cmd cmd, int x, int y, int width, int height, bool origin_top_left) {
+    if (_sgcap_begin_cmd(cmd)) {
+        _sgcap_write_int(x);
+        _sgcap_write_int(y);
+        _sgcap_write_int(width);
+        _sgcap_write_int(height);
+        _sgcap_write_u32(origin_top_left ? 1 : 0);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_apply_viewport(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)user_data;
+    _sgcap_rect_cmd(SGCAP_CMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+}
+
+_SOKOL_PRIVATE void _sgcap_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)user_data;
+    _sgcap_rect_cmd(SGCAP_CMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+}
+
+_SOKOL_PRIVATE void _sgcap_apply_pipeline(sg_pipeline pip, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_APPLY_PIPELINE, pip.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_apply_bindings(const sg_bindings* bindings, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_APPLY_BINDINGS)) {
+        _sgcap_write(bindings, sizeof(sg_bindings));
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_apply_uniforms(sg_shader_stage stage, int ub_index, const void* data, int num_bytes, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_APPLY_UNIFORMS)) {
+        _sgcap_write_int((int)stage);
+        _sgcap_write_int(ub_index);
+        _sgcap_write_int(num_bytes);
+        _sgcap_write(data, num_bytes);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_draw(int base_element, int num_elements, int num_instances, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_DRAW)) {
+        _sgcap_write_int(base_element);
+        _sgcap_write_int(num_elements);
+        _sgcap_write_int(num_instances);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_multi_draw(const sg_draw_item* items, int num_items, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_MULTI_DRAW)) {
+        _sgcap_write_int(num_items);
+        _sgcap_write(items, num_items * (int)sizeof(sg_draw_item));
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_draw_indirect(sg_buffer buf, int offset, int count, int stride, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_DRAW_INDIRECT)) {
+        _sgcap_write_u32(buf.id);
+        _sgcap_write_int(offset);
+        _sgcap_write_int(count);
+        _sgcap_write_int(stride);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_begin_occlusion_query(sg_occlusion_query query, void* user_data) {
+    (void)user_data;
+    _sgcap_id_cmd(SGCAP_CMD_BEGIN_OCCLUSION_QUERY, query.id);
+}
+
+_SOKOL_PRIVATE void _sgcap_end_occlusion_query(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_END_OCCLUSION_QUERY);
+}
+
+_SOKOL_PRIVATE void _sgcap_begin_conditional_render(sg_occlusion_query query, bool visible, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_BEGIN_CONDITIONAL_RENDER)) {
+        _sgcap_write_u32(query.id);
+        _sgcap_write_u32(visible ? 1 : 0);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_end_conditional_render(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_END_CONDITIONAL_RENDER);
+}
+
+_SOKOL_PRIVATE void _sgcap_end_pass(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_END_PASS);
+}
+
+_SOKOL_PRIVATE void _sgcap_begin_compute_pass(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_BEGIN_COMPUTE_PASS);
+}
+
+_SOKOL_PRIVATE void _sgcap_dispatch(int num_groups_x, int num_groups_y, int num_groups_z, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_DISPATCH)) {
+        _sgcap_write_int(num_groups_x);
+        _sgcap_write_int(num_groups_y);
+        _sgcap_write_int(num_groups_z);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_end_compute_pass(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_END_COMPUTE_PASS);
+}
+
+_SOKOL_PRIVATE void _sgcap_push_debug_group(const char* name, void* user_data) {
+    (void)user_data;
+    if (_sgcap_begin_cmd(SGCAP_CMD_PUSH_DEBUG_GROUP)) {
+        const int len = name ? (int)strlen(name) : 0;
+        _sgcap_write_int(len);
+        _sgcap_write(name, len);
+        _sgcap_end_cmd();
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_pop_debug_group(void* user_data) {
+    (void)user_data;
+    _sgcap_noargs_cmd(SGCAP_CMD_POP_DEBUG_GROUP);
+}
+
+/* frames which are not captured still record their sg_commit(), so that
+   resource updates end up in the right frame in the replay
+*/
+_SOKOL_PRIVATE void _sgcap_commit(void* user_data) {
+    (void)user_data;
+    const bool captured = _sgcap.cap.recording;
+    _sgcap.cap.recording = true;
+    _sgcap_begin_cmd(SGCAP_CMD_COMMIT);
+    _sgcap_write_u32(captured ? 1 : 0);
+    _sgcap_end_cmd();
+    if (_sgcap.cap.desc.frames_on_demand) {
+        if (captured && (_sgcap.cap.frames_left > 0)) {
+            _sgcap.cap.frames_left--;
+        }
+        _sgcap.cap.recording = _sgcap.cap.frames_left > 0;
+    }
+    _sgcap_flush();
+}
+
+/*== REPLAY ==================================================================*/
+_SOKOL_PRIVATE void _sgcap_read(_sgcap_reader_t* r, void* dst, int num_bytes) {
+    if (r->error || ((r->end - r->ptr) < num_bytes)) {
+        r->error = true;
+        memset(dst, 0, (size_t)num_bytes);
+        return;
+    }
+    memcpy(dst, r->ptr, (size_t)num_bytes);
+    r->ptr += num_bytes;
+}
+
+_SOKOL_PRIVATE uint32_t _sgcap_read_u32(_sgcap_reader_t* r) {
+    uint32_t val;
+    _sgcap_read(r, &val, sizeof(val));
+    return val;
+}
+
+_SOKOL_PRIVATE int _sgcap_read_int(_sgcap_reader_t* r) {
+    int val;
+    _sgcap_read(r, &val, sizeof(val));
+    return val;
+}
+
+/* returns a pointer to num_bytes of data in the capture, or 0 on error */
+_SOKOL_PRIVATE const void* _sgcap_read_data(_sgcap_reader_t* r, int num_bytes) {
+    if (r->error || (num_bytes < 0) || ((r->end - r->ptr) < num_bytes)) {
+        r->error = true;
+        return 0;
+    }
+    const void* ptr = r->ptr;
+    r->ptr += num_bytes;
+    return ptr;
+}
+
+/* the counterpart of _sgcap_write_ptr(), takes the captured pointer value
+   and returns the pointer to the data in the capture
+*/
+_SOKOL_PRIVATE const void* _sgcap_read_ptr(_sgcap_reader_t* r, const void* captured_ptr) {
+    if (0 == captured_ptr) {
+        return 0;
+    }
+    const int num_bytes = (int) _sgcap_read_u32(r);
+    return _sgcap_read_data(r, num_bytes);
+}
+
+_SOKOL_PRIVATE void _sgcap_read_image_content(_sgcap_reader_t* r, sg_image_content* content) {
+    for (int face = 0; face < SG_CUBEFACE_NUM; face++) {
+        for (int mip = 0; mip < SG_MAX_MIPMAPS; mip++) {
+            sg_subimage_content* sub = &content->subimage[face][mip];
+            sub->ptr = _sgcap_read_ptr(r, sub->ptr);
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_read_shader_stage(_sgcap_reader_t* r, sg_shader_stage_desc* stage) {
+    stage->source = (const char*) _sgcap_read_ptr(r, stage->source);
+    stage->byte_code = (const uint8_t*) _sgcap_read_ptr(r, stage->byte_code);
+    stage->entry = (const char*) _sgcap_read_ptr(r, stage->entry);
+    stage->d3d11_target = (const char*) _sgcap_read_ptr(r, stage->d3d11_target);
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+            sg_shader_uniform_desc* u = &stage->uniform_blocks[ub_index].uniforms[u_index];
+            u->name = (const char*) _sgcap_read_ptr(r, u->name);
+        }
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        sg_shader_image_desc* img = &stage->images[img_index];
+        img->name = (const char*) _sgcap_read_ptr(r, img->name);
+    }
+}
+
+/* map a captured resource id to the id of the resource created by the replay */
+_SOKOL_PRIVATE uint32_t* _sgcap_id_slot(int res_type, uint32_t captured_id) {
+    const int slot_index = (int)(captured_id & _SGCAP_SLOT_MASK);
+    if ((SG_INVALID_ID == captured_id) || (slot_index >= _sgcap.rep.pool_size[res_type])) {
+        return 0;
+    }
+    return &_sgcap.rep.ids[res_type][slot_index];
+}
+
+_SOKOL_PRIVATE uint32_t _sgcap_map_id(int res_type, uint32_t captured_id) {
+    const uint32_t* slot = _sgcap_id_slot(res_type, captured_id);
+    return slot ? *slot : (uint32_t)SG_INVALID_ID;
+}
+
+_SOKOL_PRIVATE void _sgcap_set_id(int res_type, uint32_t captured_id, uint32_t replay_id) {
+    uint32_t* slot = _sgcap_id_slot(res_type, captured_id);
+    if (slot) {
+        *slot = replay_id;
+    }
+}
+
+_SOKOL_PRIVATE sg_buffer _sgcap_buffer(uint32_t captured_id) {
+    sg_buffer buf = { _sgcap_map_id(_SGCAP_RES_BUFFER, captured_id) };
+    return buf;
+}
+
+_SOKOL_PRIVATE sg_image _sgcap_image(uint32_t captured_id) {
+    sg_image img = { _sgcap_map_id(_SGCAP_RES_IMAGE, captured_id) };
+    return img;
+}
+
+_SOKOL_PRIVATE sg_occlusion_query _sgcap_query(uint32_t captured_id) {
+    sg_occlusion_query query = { _sgcap_map_id(_SGCAP_RES_OCCLUSION_QUERY, captured_id) };
+    return query;
+}
+
+_SOKOL_PRIVATE void _sgcap_readback_noop(const sg_image_readback* readback) {
+    (void)readback;
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_make_buffer(_sgcap_reader_t* r) {
+    const uint32_t id = _sgcap_read_u32(r);
+    sg_buffer_desc desc;
+    _sgcap_read(r, &desc, sizeof(desc));
+    desc.content = _sgcap_read_ptr(r, desc.content);
+    desc.label = (const char*) _sgcap_read_ptr(r, desc.label);
+    /* native buffers can't be replayed */
+    memset(desc.gl_buffers, 0, sizeof(desc.gl_buffers));
+    memset((void*)desc.mtl_buffers, 0, sizeof(desc.mtl_buffers));
+    desc.d3d11_buffer = 0;
+    desc.wgpu_buffer = 0;
+    if (!r->error) {
+        _sgcap_set_id(_SGCAP_RES_BUFFER, id, sg_make_buffer(&desc).id);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_make_image(_sgcap_reader_t* r) {
+    const uint32_t id = _sgcap_read_u32(r);
+    sg_image_desc desc;
+    _sgcap_read(r, &desc, sizeof(desc));
+    _sgcap_read_image_content(r, &desc.content);
+    desc.label = (const char*) _sgcap_read_ptr(r, desc.label);
+    memset(desc.gl_textures, 0, sizeof(desc.gl_textures));
+    memset((void*)desc.mtl_textures, 0, sizeof(desc.mtl_textures));
+    desc.d3d11_texture = 0;
+    desc.wgpu_texture = 0;
+    if (!r->error) {
+        _sgcap_set_id(_SGCAP_RES_IMAGE, id, sg_make_image(&desc).id);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_make_shader(_sgcap_reader_t* r) {
+    const uint32_t id = _sgcap_read_u32(r);
+    sg_shader_desc desc;
+    _sgcap_read(r, &desc, sizeof(desc));
+    _sgcap_clear_sw_shader(&desc.sw);
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        desc.attrs[i].name = (const char*) _sgcap_read_ptr(r, desc.attrs[i].name);
+        desc.attrs[i].sem_name = (const char*) _sgcap_read_ptr(r, desc.attrs[i].sem_name);
+    }
+    _sgcap_read_shader_stage(r, &desc.vs);
+    _sgcap_read_shader_stage(r, &desc.fs);
+    _sgcap_read_shader_stage(r, &desc.cs);
+    desc.label = (const char*) _sgcap_read_ptr(r, desc.label);
+    if (!r->error) {
+        _sgcap_set_id(_SGCAP_RES_SHADER, id, sg_make_shader(&desc).id);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_make_pipeline(_sgcap_reader_t* r) {
+    const uint32_t id = _sgcap_read_u32(r);
+    sg_pipeline_desc desc;
+    _sgcap_read(r, &desc, sizeof(desc));
+    desc.label = (const char*) _sgcap_read_ptr(r, desc.label);
+    desc.shader.id = _sgcap_map_id(_SGCAP_RES_SHADER, desc.shader.id);
+    if (!r->error) {
+        _sgcap_set_id(_SGCAP_RES_PIPELINE, id, sg_make_pipeline(&desc).id);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_make_pass(_sgcap_reader_t* r) {
+    const uint32_t id = _sgcap_read_u32(r);
+    sg_pass_desc desc;
+    _sgcap_read(r, &desc, sizeof(desc));
+    desc.label = (const char*) _sgcap_read_ptr(r, desc.label);
+    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+        desc.color_attachments[i].image = _sgcap_image(desc.color_attachments[i].image.id);
+    }
+    desc.depth_stencil_attachment.image = _sgcap_image(desc.depth_stencil_attachment.image.id);
+    if (!r->error) {
+        _sgcap_set_id(_SGCAP_RES_PASS, id, sg_make_pass(&desc).id);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_make_occlusion_query(_sgcap_reader_t* r) {
+    const uint32_t id = _sgcap_read_u32(r);
+    sg_occlusion_query_desc desc;
+    _sgcap_read(r, &desc, sizeof(desc));
+    desc.label = (const char*) _sgcap_read_ptr(r, desc.label);
+    if (!r->error) {
+        _sgcap_set_id(_SGCAP_RES_OCCLUSION_QUERY, id, sg_make_occlusion_query(&desc).id);
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_destroy(int res_type, uint32_t id) {
+    if (SG_INVALID_ID == id) {
+        return;
+    }
+    switch (res_type) {
+        case _SGCAP_RES_BUFFER: { sg_buffer buf = { id }; sg_destroy_buffer(buf); } break;
+        case _SGCAP_RES_IMAGE: { sg_image img = { id }; sg_destroy_image(img); } break;
+        case _SGCAP_RES_SHADER: { sg_shader shd = { id }; sg_destroy_shader(shd); } break;
+        case _SGCAP_RES_PIPELINE: { sg_pipeline pip = { id }; sg_destroy_pipeline(pip); } break;
+        case _SGCAP_RES_PASS: { sg_pass pass = { id }; sg_destroy_pass(pass); } break;
+        case _SGCAP_RES_OCCLUSION_QUERY: { sg_occlusion_query query = { id }; sg_destroy_occlusion_query(query); } break;
+        default: break;
+    }
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_destroy(_sgcap_reader_t* r, int res_type) {
+    const uint32_t captured_id = _sgcap_read_u32(r);
+    _sgcap_destroy(res_type, _sgcap_map_id(res_type, captured_id));
+    _sgcap_set_id(res_type, captured_id, SG_INVALID_ID);
+}
+
+_SOKOL_PRIVATE void _sgcap_replay_apply_bindings(_sgcap_reader_t* r) {
+    sg_bindings bnd;
+    _sgcap_read(r, &bnd, sizeof(bnd));
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        bnd.vertex_buffers[i] = _sgcap_buffer(bnd.vertex_buffers[i].id);
+    }
+    bnd.index_buffer = _sgcap_buffer(bnd.index_buffer.id);
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        bnd.vs_images[i] = _sgcap_image(bnd.vs_images[i].id);
+        bnd.fs_images[i] = _sgcap_image(bnd.fs_images[i].id);
+        bnd.cs_images[i] = _sgcap_image(bnd.cs_images[i].id);
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_STORAGEBUFFERS; i++) {
+        bnd.storage_buffers[i] = _sgcap_buffer(bnd.storage_buffers[i].id);
+    }
+    if (!r->error) {
+        sg_apply_bindings(&bnd);
+    }
+}
+
+/* execute one recorded call, the reader only covers the payload of the record */
+_SOKOL_PRIVATE void _sgcap_replay_cmd(sgcap_cmd cmd, _sgcap_reader_t* r) {
+    if (_sgcap.rep.cond_render_occluded &&
+        ((SGCAP_CMD_DRAW == cmd) || (SGCAP_CMD_MULTI_DRAW == cmd) || (SGCAP_CMD_DRAW_INDIRECT == cmd)))
+    {
+        /* sokol_gfx dropped these draw calls when the capture was recorded */
+        return;
+    }
+    switch (cmd) {
+        case SGCAP_CMD_MAKE_BUFFER:             _sgcap_replay_make_buffer(r); break;
+        case SGCAP_CMD_MAKE_IMAGE:              _sgcap_replay_make_image(r); break;
+        case SGCAP_CMD_MAKE_SHADER:             _sgcap_replay_make_shader(r); break;
+        case SGCAP_CMD_MAKE_PIPELINE:           _sgcap_replay_make_pipeline(r); break;
+        case SGCAP_CMD_MAKE_PASS:               _sgcap_replay_make_pass(r); break;
+        case SGCAP_CMD_MAKE_OCCLUSION_QUERY:    _sgcap_replay_make_occlusion_query(r); break;
+        case SGCAP_CMD_DESTROY_BUFFER:          _sgcap_replay_destroy(r, _SGCAP_RES_BUFFER); break;
+        case SGCAP_CMD_DESTROY_IMAGE:           _sgcap_replay_destroy(r, _SGCAP_RES_IMAGE); break;
+        case SGCAP_CMD_DESTROY_SHADER:          _sgcap_replay_destroy(r, _SGCAP_RES_SHADER); break;
+        case SGCAP_CMD_DESTROY_PIPELINE:        _sgcap_replay_destroy(r, _SGCAP_RES_PIPELINE); break;
+        case SGCAP_CMD_DESTROY_PASS:            _sgcap_replay_destroy(r, _SGCAP_RES_PASS); break;
+        case SGCAP_CMD_DESTROY_OCCLUSION_QUERY: _sgcap_replay_destroy(r, _SGCAP_RES_OCCLUSION_QUERY); break;
+        case SGCAP_CMD_UPDATE_BUFFER:
+        case SGCAP_CMD_APPEND_BUFFER:
+            {
+                const sg_buffer buf = _sgcap_buffer(_sgcap_read_u32(r));
+                const int num_bytes = _sgcap_read_int(r);
+                const void* data = _sgcap_read_data(r, num_bytes);
+                if (!r->error) {
+                    if (SGCAP_CMD_UPDATE_BUFFER == cmd) {
+                        sg_update_buffer(buf, data, num_bytes);
+                    }
+                    else {
+                        sg_append_buffer(buf, data, num_bytes);
+                    }
+                }
+            }
+            break;
+        case SGCAP_CMD_UPDATE_IMAGE:
+            {
+                const sg_image img = _sgcap_image(_sgcap_read_u32(r));
+                sg_image_content content;
+                _sgcap_read(r, &content, sizeof(content));
+                _sgcap_read_image_content(r, &content);
+                if (!r->error) {
+                    sg_update_image(img, &content);
+                }
+            }
+            break;
+        case SGCAP_CMD_GENERATE_MIPMAPS:
+            sg_generate_mipmaps(_sgcap_image(_sgcap_read_u32(r)));
+            break;
+        case SGCAP_CMD_READ_IMAGE_ASYNC:
+            {
+                const sg_image img = _sgcap_image(_sgcap_read_u32(r));
+                const int x = _sgcap_read_int(r);
+                const int y = _sgcap_read_int(r);
+                const int w = _sgcap_read_int(r);
+                const int h = _sgcap_read_int(r);
+                if (!r->error) {
+                    sg_read_image_async(img, x, y, w, h, _sgcap_readback_noop, 0);
+                }
+            }
+            break;
+        case SGCAP_CMD_RESET_STATE_CACHE:
+            sg_reset_state_cache();
+            break;
+        case SGCAP_CMD_INVALIDATE_STATE_CACHE:
+            {
+                sg_dirty_state dirty;
+                _sgcap_read(r, &dirty, sizeof(dirty));
+                sg_invalidate_state_cache(&dirty);
+            }
+            break;
+        case SGCAP_CMD_BEGIN_DEFAULT_PASS:
+            {
+                sg_pass_action action;
+                _sgcap_read(r, &action, sizeof(action));
+                const int w = _sgcap_read_int(r);
+                const int h = _sgcap_read_int(r);
+                sg_begin_default_pass(&action, w, h);
+            }
+            break;
+        case SGCAP_CMD_BEGIN_PASS:
+            {
+                const sg_pass pass = { _sgcap_map_id(_SGCAP_RES_PASS, _sgcap_read_u32(r)) };
+                sg_pass_action action;
+                _sgcap_read(r, &action, sizeof(action));
+                sg_begin_pass(pass, &action);
+            }
+            break;
+        case SGCAP_CMD_APPLY_VIEWPORT:
+        case SGCAP_CMD_APPLY_SCISSOR_RECT:
+            {
+                const int x = _sgcap_read_int(r);
+                const int y = _sgcap_read_int(r);
+                const int w = _sgcap_read_int(r);
+                const int h = _sgcap_read_int(r);
+                const bool origin_top_left = 0 != _sgcap_read_u32(r);
+                if (SGCAP_CMD_APPLY_VIEWPORT == cmd) {
+                    sg_apply_viewport(x, y, w, h, origin_top_left);
+                }
+                else {
+                    sg_apply_scissor_rect(x, y, w, h, origin_top_left);
+                }
+            }
+            break;
+        case SGCAP_CMD_APPLY_PIPELINE:
+            {
+                const sg_pipeline pip = { _sgcap_map_id(_SGCAP_RES_PIPELINE, _sgcap_read_u32(r)) };
+                sg_apply_pipeline(pip);
+            }
+            break;
+        case SGCAP_CMD_APPLY_BINDINGS:
+            _sgcap_replay_apply_bindings(r);
+            break;
+        case SGCAP_CMD_APPLY_UNIFORMS:
+            {
+                const sg_shader_stage stage = (sg_shader_stage) _sgcap_read_int(r);
+                const int ub_index = _sgcap_read_int(r);
+                const int num_bytes = _sgcap_read_int(r);
+                const void* data = _sgcap_read_data(r, num_bytes);
+                if (!r->error) {
+                    sg_apply_uniforms(stage, ub_index, data, num_bytes);
+                }
+            }
+            break;
+        case SGCAP_CMD_DRAW:
+            {
+                const int base_element = _sgcap_read_int(r);
+                const int num_elements = _sgcap_read_int(r);
+                const int num_instances = _sgcap_read_int(r);
+                sg_draw(base_element, num_elements, num_instances);
+            }
+            break;
+        case SGCAP_CMD_MULTI_DRAW:
+            {
+                const int num_items = _sgcap_read_int(r);
+                const sg_draw_item* items = (const sg_draw_item*) _sgcap_read_data(r, num_items * (int)sizeof(sg_draw_item));
+                if (!r->error && (num_items > 0)) {
+                    /* the items in the capture may not be aligned */
+                    sg_draw_item* aligned_items = (sg_draw_item*) SOKOL_MALLOC((size_t)num_items * sizeof(sg_draw_item));
+                    SOKOL_ASSERT(aligned_items);
+                    memcpy(aligned_items, items, (size_t)num_items * sizeof(sg_draw_item));
+                    sg_multi_draw(aligned_items, num_items);
+                    SOKOL_FREE(aligned_items);
+                }
+            }
+            break;
+        case SGCAP_CMD_DRAW_INDIRECT:
+            {
+                const sg_buffer buf = _sgcap_buffer(_sgcap_read_u32(r));
+                const int offset = _sgcap_read_int(r);
+                const int count = _sgcap_read_int(r);
+                const int stride = _sgcap_read_int(r);
+                sg_draw_indirect(buf, offset, count, stride);
+            }
+            break;
+        case SGCAP_CMD_BEGIN_OCCLUSION_QUERY:
+            sg_begin_occlusion_query(_sgcap_query(_sgcap_read_u32(r)));
+            break;
+        case SGCAP_CMD_END_OCCLUSION_QUERY:
+            sg_end_occlusion_query();
+            break;
+        case SGCAP_CMD_BEGIN_CONDITIONAL_RENDER:
+            {
+                /* the replayed query results may differ, so use the visibility seen by the capture */
+                const sg_occlusion_query query = _sgcap_query(_sgcap_read_u32(r));
+                const bool visible = 0 != _sgcap_read_u32(r);
+                sg_begin_conditional_render(query);
+                _sgcap.rep.cond_render_occluded = !visible;
+            }
+            break;
+        case SGCAP_CMD_END_CONDITIONAL_RENDER:
+            sg_end_conditional_render();
+            _sgcap.rep.cond_render_occluded = false;
+            break;
+        case SGCAP_CMD_END_PASS:
+            sg_end_pass();
+            break;
+        case SGCAP_CMD_BEGIN_COMPUTE_PASS:
+            sg_begin_compute_pass();
+            break;
+        case SGCAP_CMD_DISPATCH:
+            {
+                const int x = _sgcap_read_int(r);
+                const int y = _sgcap_read_int(r);
+                const int z = _sgcap_read_int(r);
+                sg_dispatch(x, y, z);
+            }
+            break;
+        case SGCAP_CMD_END_COMPUTE_PASS:
+            sg_end_compute_pass();
+            break;
+        case SGCAP_CMD_PUSH_DEBUG_GROUP:
+            {
+                char name[64];
+                int len = _sgcap_read_int(r);
+                const void* str = _sgcap_read_data(r, len);
+                if (!r->error) {
+                    if (len > (int)sizeof(name) - 1) {
+                        len = (int)sizeof(name) - 1;
+                    }
+                    memcpy(name, str, (size_t)len);
+                    name[len] = 0;
+                    sg_push_debug_group(name);
+                }
+            }
+            break;
+        case SGCAP_CMD_POP_DEBUG_GROUP:
+            sg_pop_debug_group();
+            break;
+        case SGCAP_CMD_COMMIT:
+            sg_commit();
+            break;
+        default:
+            /* unknown records are skipped */
+            break;
+    }
+}
+
+/* the software backend can't create the captured shaders, their callbacks aren't recorded */
+_SOKOL_PRIVATE bool _sgcap_backend_can_replay(void) {
+    #if defined(SOKOL_SOFTWARE)
+        return false;
+    #else
+        return true;
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sgcap_read_header(const void* data, int num_bytes, _sgcap_header_t* out_hdr) {
+    if (!data || (num_bytes < (int)sizeof(_sgcap_header_t))) {
+        SOKOL_LOG("sokol_gfx_capture.h: capture data too small");
+        return false;
+    }
+    memcpy(out_hdr, data, sizeof(_sgcap_header_t));
+    if ((out_hdr->magic != _SGCAP_MAGIC) || (out_hdr->version != _SGCAP_VERSION)) {
+        SOKOL_LOG("sokol_gfx_capture.h: not a capture, or unsupported version");
+        return false;
+    }
+    _sgcap_header_t ref_hdr;
+    _sgcap_init_header(&ref_hdr, 0);
+    if (0 != memcmp(ref_hdr.struct_size, out_hdr->struct_size, sizeof(ref_hdr.struct_size))) {
+        SOKOL_LOG("sokol_gfx_capture.h: capture was recorded with a different sokol_gfx.h version");
+        return false;
+    }
+    return true;
+}
+
+/*== PUBLIC API FUNCTIONS ====================================================*/
+SOKOL_API_IMPL bool sgcap_begin(const sgcap_desc* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(!_sgcap.cap.valid);
+    SOKOL_ASSERT(desc->path || desc->write_cb);
+    memset(&_sgcap.cap, 0, sizeof(_sgcap.cap));
+    _sgcap.cap.desc = *desc;
+    if (desc->path) {
+        _sgcap.cap.file = fopen(desc->path, "wb");
+        if (0 == _sgcap.cap.file) {
+            SOKOL_LOG("sgcap_begin: failed to open capture file");
+            return false;
+        }
+    }
+    _sgcap.cap.buf_size = _SGCAP_INITIAL_BUFFER_SIZE;
+    _sgcap.cap.buf = (uint8_t*) SOKOL_MALLOC((size_t)_sgcap.cap.buf_size);
+    SOKOL_ASSERT(_sgcap.cap.buf);
+    _sgcap.cap.recording = !desc->frames_on_demand;
+    _sgcap.cap.valid = true;
+
+    const sg_desc sgdesc = sg_query_desc();
+    _sgcap_header_t hdr;
+    _sgcap_init_header(&hdr, &sgdesc);
+    _sgcap_write(&hdr, sizeof(hdr));
+    _sgcap_flush();
+
+    sg_trace_hooks hooks;
+    memset(&hooks, 0, sizeof(hooks));
+    hooks.reset_state_cache = _sgcap_reset_state_cache;
+    hooks.invalidate_state_cache = _sgcap_invalidate_state_cache;
+    hooks.make_buffer = _sgcap_make_buffer;
+    hooks.make_image = _sgcap_make_image;
+    hooks.make_shader = _sgcap_make_shader;
+    hooks.make_pipeline = _sgcap_make_pipeline;
+    hooks.make_pass = _sgcap_make_pass;
+    hooks.make_occlusion_query = _sgcap_make_occlusion_query;
+    hooks.destroy_buffer = _sgcap_destroy_buffer;
+    hooks.destroy_image = _sgcap_destroy_image;
+    hooks.destroy_shader = _sgcap_destroy_shader;
+    hooks.destroy_pipeline = _sgcap_destroy_pipeline;
+    hooks.destroy_pass = _sgcap_destroy_pass;
+    hooks.destroy_occlusion_query = _sgcap_destroy_occlusion_query;
+    hooks.update_buffer = _sgcap_update_buffer;
+    hooks.update_image = _sgcap_update_image;
+    hooks.generate_mipmaps = _sgcap_generate_mipmaps;
+    hooks.read_image_async = _sgcap_read_image_async;
+    hooks.append_buffer = _sgcap_append_buffer;
+    hooks.begin_default_pass = _sgcap_begin_default_pass;
+    hooks.begin_pass = _sgcap_begin_pass;
+    hooks.apply_viewport = _sgcap_apply_viewport;
+    hooks.apply_scissor_rect = _sgcap_apply_scissor_rect;
+    hooks.apply_pipeline = _sgcap_apply_pipeline;
+    hooks.apply_bindings = _sgcap_apply_bindings;
+    hooks.apply_uniforms = _sgcap_apply_uniforms;
+    hooks.draw = _sgcap_draw;
+    hooks.multi_draw = _sgcap_multi_draw;
+    hooks.draw_indirect = _sgcap_draw_indirect;
+    hooks.begin_occlusion_query = _sgcap_begin_occlusion_query;
+    hooks.end_occlusion_query = _sgcap_end_occlusion_query;
+    hooks.begin_conditional_render = _sgcap_begin_conditional_render;
+    hooks.end_conditional_render = _sgcap_end_conditional_render;
+    hooks.end_pass = _sgcap_end_pass;
+    hooks.begin_compute_pass = _sgcap_begin_compute_pass;
+    hooks.dispatch = _sgcap_dispatch;
+    hooks.end_compute_pass = _sgcap_end_compute_pass;
+    hooks.commit = _sgcap_commit;
+    hooks.init_buffer = _sgcap_init_buffer;
+    hooks.init_image = _sgcap_init_image;
+    hooks.init_shader = _sgcap_init_shader;
+    hooks.init_pipeline = _sgcap_init_pipeline;
+    hooks.init_pass = _sgcap_init_pass;
+    hooks.push_debug_group = _sgcap_push_debug_group;
+    hooks.pop_debug_group = _sgcap_pop_debug_group;
+    _sgcap.cap.prev_hooks = sg_install_trace_hooks(&hooks);
+    return true;
+}
+
+SOKOL_API_IMPL void sgcap_capture_frames(int num_frames) {
+    SOKOL_ASSERT(_sgcap.cap.valid);
+    SOKOL_ASSERT(num_frames >= 0);
+    _sgcap.cap.frames_left = num_frames;
+}
+
+SOKOL_API_IMPL bool sgcap_capturing(void) {
+    return _sgcap.cap.valid;
+}
+
+SOKOL_API_IMPL void sgcap_end(void) {
+    SOKOL_ASSERT(_sgcap.cap.valid);
+    sg_install_trace_hooks(&_sgcap.cap.prev_hooks);
+    _sgcap_flush();
+    if (_sgcap.cap.file) {
+        fclose(_sgcap.cap.file);
+    }
+    SOKOL_FREE(_sgcap.cap.buf);
+    memset(&_sgcap.cap, 0, sizeof(_sgcap.cap));
+}
+
+SOKOL_API_IMPL bool sgcap_query_capture_info(const void* data, int num_bytes, sgcap_capture_info* out_info) {
+    SOKOL_ASSERT(out_info);
+    memset(out_info, 0, sizeof(sgcap_capture_info));
+    _sgcap_header_t hdr;
+    if (!_sgcap_read_header(data, num_bytes, &hdr)) {
+        return false;
+    }
+    out_info->backend = (sg_backend) hdr.backend;
+    out_info->buffer_pool_size = (int) hdr.pool_size[_SGCAP_RES_BUFFER];
+    out_info->image_pool_size = (int) hdr.pool_size[_SGCAP_RES_IMAGE];
+    out_info->shader_pool_size = (int) hdr.pool_size[_SGCAP_RES_SHADER];
+    out_info->pipeline_pool_size = (int) hdr.pool_size[_SGCAP_RES_PIPELINE];
+    out_info->pass_pool_size = (int) hdr.pool_size[_SGCAP_RES_PASS];
+    out_info->occlusion_query_pool_size = (int) hdr.pool_size[_SGCAP_RES_OCCLUSION_QUERY];
+    _sgcap_reader_t r;
+    r.ptr = (const uint8_t*)data + sizeof(_sgcap_header_t);
+    r.end = (const uint8_t*)data + num_bytes;
+    r.error = false;
+    while (r.ptr < r.end) {
+        const uint32_t cmd = _sgcap_read_u32(&r);
+        const uint32_t payload_size = _sgcap_read_u32(&r);
+        _sgcap_reader_t payload;
+        payload.ptr = (const uint8_t*) _sgcap_read_data(&r, (int)payload_size);
+        payload.end = payload.ptr + payload_size;
+        payload.error = false;
+        if (r.error) {
+            break;
+        }
+        out_info->num_calls++;
+        if ((SGCAP_CMD_COMMIT == cmd) && (0 != _sgcap_read_u32(&payload))) {
+            out_info->num_frames++;
+        }
+    }
+    return true;
+}
+
+SOKOL_API_IMPL bool sgcap_replay_begin(const void* data, int num_bytes) {
+    SOKOL_ASSERT(!_sgcap.rep.valid);
+    SOKOL_ASSERT(!_sgcap.cap.valid);
+    if (!_sgcap_backend_can_replay()) {
+        SOKOL_LOG("sokol_gfx_capture.h: captures can't be replayed on the software backend");
+        return false;
+    }
+    _sgcap_header_t hdr;
+    if (!_sgcap_read_header(data, num_bytes, &hdr)) {
+        return false;
+    }
+    memset(&_sgcap.rep, 0, sizeof(_sgcap.rep));
+    for (int i = 0; i < _SGCAP_RES_NUM; i++) {
+        /* pool slot 0 is never used, the pool sizes don't include it */
+        _sgcap.rep.pool_size[i] = (int)hdr.pool_size[i] + 1;
+        const size_t size = (size_t)_sgcap.rep.pool_size[i] * sizeof(uint32_t);
+        _sgcap.rep.ids[i] = (uint32_t*) SOKOL_MALLOC(size);
+        SOKOL_ASSERT(_sgcap.rep.ids[i]);
+        memset(_sgcap.rep.ids[i], 0, size);
+    }
+    _sgcap.rep.reader.ptr = (const uint8_t*)data + sizeof(_sgcap_header_t);
+    _sgcap.rep.reader.end = (const uint8_t*)data + num_bytes;
+    _sgcap.rep.reader.error = false;
+    for (int i = 0; i < SGCAP_CMD_NUM; i++) {
+        _sgcap.rep.stats.calls[i].name = _sgcap_cmd_names[i];
+    }
+    _sgcap.rep.valid = true;
+    return true;
+}
+
+SOKOL_API_IMPL bool sgcap_replay_frame(void) {
+    SOKOL_ASSERT(_sgcap.rep.valid);
+    _sgcap_reader_t* r = &_sgcap.rep.reader;
+    const uint64_t frame_start = _sgcap_now_ns();
+    while ((r->ptr < r->end) && !r->error) {
+        const sgcap_cmd cmd = (sgcap_cmd) _sgcap_read_u32(r);
+        const uint32_t payload_size = _sgcap_read_u32(r);
+        _sgcap_reader_t payload;
+        payload.ptr = (const uint8_t*) _sgcap_read_data(r, (int)payload_size);
+        payload.end = payload.ptr + payload_size;
+        payload.error = false;
+        if (r->error) {
+            break;
+        }
+        /* only the sg_commit() of captured frames ends a frame */
+        bool end_of_frame = false;
+        if (SGCAP_CMD_COMMIT == cmd) {
+            _sgcap_reader_t commit_payload = payload;
+            end_of_frame = 0 != _sgcap_read_u32(&commit_payload);
+        }
+        const uint64_t t0 = _sgcap_now_ns();
+        _sgcap_replay_cmd(cmd, &payload);
+        const uint64_t dt = _sgcap_now_ns() - t0;
+        if (payload.error) {
+            SOKOL_LOG("sgcap_replay_frame: corrupt record in capture");
+        }
+        if ((cmd > SGCAP_CMD_INVALID) && (cmd < SGCAP_CMD_NUM)) {
+            sgcap_call_stats* call_stats = &_sgcap.rep.stats.calls[cmd];
+            call_stats->num_calls++;
+            call_stats->total_ns += dt;
+            if (dt > call_stats->max_ns) {
+                call_stats->max_ns = dt;
+            }
+        }
+        if (end_of_frame) {
+            const uint64_t frame_ns = _sgcap_now_ns() - frame_start;
+            sgcap_replay_stats* stats = &_sgcap.rep.stats;
+            if ((0 == stats->num_frames) || (frame_ns < stats->min_frame_ns)) {
+                stats->min_frame_ns = frame_ns;
+            }
+            if (frame_ns > stats->max_frame_ns) {
+                stats->max_frame_ns = frame_ns;
+            }
+            stats->total_frame_ns += frame_ns;
+            stats->num_frames++;
+            return true;
+        }
+    }
+    if (r->error) {
+        SOKOL_LOG("sgcap_replay_frame: capture is truncated");
+    }
+    return false;
+}
+
+SOKOL_API_IMPL sgcap_replay_stats sgcap_query_replay_stats(void) {
+    SOKOL_ASSERT(_sgcap.rep.valid);
+    return _sgcap.rep.stats;
+}
+
+SOKOL_API_IMPL void sgcap_replay_end(void) {
+    SOKOL_ASSERT(_sgcap.rep.valid);
+    /* destroy the resources which are still alive, in reverse dependency order */
+    static const int destroy_order[_SGCAP_RES_NUM] = {
+        _SGCAP_RES_PASS,
+        _SGCAP_RES_PIPELINE,
+        _SGCAP_RES_SHADER,
+        _SGCAP_RES_IMAGE,
+        _SGCAP_RES_BUFFER,
+        _SGCAP_RES_OCCLUSION_QUERY
+    };
+    for (int i = 0; i < _SGCAP_RES_NUM; i++) {
+        const int res_type = destroy_order[i];
+        for (int slot_index = 0; slot_index < _sgcap.rep.pool_size[res_type]; slot_index++) {
+            _sgcap_destroy(res_type, _sgcap.rep.ids[res_type][slot_index]);
+        }
+    }
+    for (int i = 0; i < _SGCAP_RES_NUM; i++) {
+        SOKOL_FREE(_sgcap.rep.ids[i]);
+    }
+    memset(&_sgcap.rep, 0, sizeof(_sgcap.rep));
+}
+
+#endif /* SOKOL_IMPL */
@@ -0,0 +1,1082 @@
+#ifndef SOKOL_IMM_INCLUDED
+/*
+    sokol_imm.h -- batched immediate-mode primitive rendering on top of sokol_gfx.h
+
+    Project URL: https://github.com/Aftnet/sokol_app_uwp
+
+    Do this:
+        #define SOKOL_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    The same sokol_gfx.h backend define must be used as for the sokol_gfx.h
+    implementation (SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11,
+    SOKOL_METAL, SOKOL_SOFTWARE or SOKOL_DUMMY_BACKEND), this selects the
+    embedded shaders. The WebGPU backend isn't supported because it requires
+    precompiled shader byte code.
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_LOG(msg)      - your own logging function (default: puts(msg))
+    SOKOL_API_DECL      - public function declaration prefix (default: extern)
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sg_desc.allocator is provided, sokol_imm.h allocates its memory
+    through the same callbacks instead of SOKOL_MALLOC and SOKOL_FREE
+    (the vertex, batch and pipeline arrays with SG_ALLOCCATEGORY_RESOURCES,
+    scratch memory with SG_ALLOCCATEGORY_TEMP).
+
+    If sokol_imm.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    Include the following headers before including sokol_imm.h:
+
+        sokol_gfx.h
+
+    OVERVIEW
+    ========
+    HUDs, debug lines and sprites are made of many small primitives, which
+    are expensive to render with one buffer or one draw call per element.
+
+    sokol_imm.h records such primitives with an immediate-mode API
+    (simm_begin(), simm_v2f() etc... and simm_end()) into a CPU-side vertex
+    array and renders them with few draw calls:
+
+    - consecutive primitives with the same primitive type, pipeline,
+      texture, scissor rect and transform are merged into a single batch
+      (except line strips and triangle strips)
+    - all vertices recorded between two simm_draw() calls are copied
+      into a single stream buffer with one sg_append_buffer() call
+    - quads are rendered as indexed triangles with a shared index buffer,
+      so that a sprite costs 4 vertices
+    - redundant sg_apply_pipeline(), sg_apply_bindings() and
+      sg_apply_uniforms() calls between batches are skipped
+
+    The stream buffer is created with sg_buffer_desc.append_grow, if the
+    vertices of one frame don't fit (because simm_draw() is called several
+    times per frame), the batches of that simm_draw() call are skipped and
+    the buffer is grown in sg_commit().
+
+    STEP BY STEP
+    ============
+    --- call simm_setup() after sg_setup():
+
+            simm_setup(&(simm_desc){0});
+
+        Optionally override the following simm_desc items:
+
+            .max_vertices       - max number of vertices between two simm_draw()
+                                  calls (default: 262144, or 65536 sprites)
+            .max_commands       - max number of batches between two simm_draw()
+                                  calls (default: 4096)
+            .pipeline_pool_size - max number of simm_pipeline objects (default: 16)
+            .color_format       - the color format of the default pipeline
+                                  (default: sg_desc.context.color_format)
+            .depth_format       - the depth format of the default pipeline
+                                  (default: sg_desc.context.depth_format)
+            .sample_count       - the MSAA sample count of the default pipeline
+                                  (default: sg_desc.context.sample_count)
+
+        A quad takes 4 vertices of 24 bytes, size .max_vertices as 4 times
+        the number of sprites rendered per simm_draw() call. For instance,
+        300000 sprites need .max_vertices = 1200000, which takes about 29 MB
+        of CPU memory and a vertex buffer of the same size. Batches are
+        only split by render state changes, so .max_commands can usually
+        stay small.
+
+    --- optionally create pipelines with a different render state than the
+        default pipeline (alpha blending, no depth test, no culling):
+
+            simm_pipeline pip = simm_make_pipeline(&(sg_pipeline_desc){
+                .depth_stencil = { ... },
+                .blend = { ... },
+                .rasterizer = { ... }
+            });
+
+        The shader, vertex layout, primitive type and index type are
+        provided by sokol_imm.h, and one sg_pipeline is created for each
+        primitive type.
+
+    --- set the render state for the following primitives, this is only
+        allowed outside simm_begin()/simm_end():
+
+            simm_defaults()                 - reset everything below
+            simm_load_pipeline(pip)         - the pipeline for the next primitives
+            simm_texture(img)               - the texture, or SG_INVALID_ID for none
+            simm_scissor_rect(x, y, w, h, origin_top_left)
+            simm_disable_scissor()
+            simm_transform(const float m[16])   - a column-major model-view-projection matrix
+            simm_ortho(left, right, bottom, top, znear, zfar)
+
+    --- record primitives:
+
+            simm_begin(SIMM_PRIMITIVETYPE_QUADS);
+            simm_v2f_t2f_c1i(x0, y0, u0, v0, 0xFFFFFFFF);
+            simm_v2f_t2f_c1i(x1, y0, u1, v0, 0xFFFFFFFF);
+            simm_v2f_t2f_c1i(x1, y1, u1, v1, 0xFFFFFFFF);
+            simm_v2f_t2f_c1i(x0, y1, u0, v1, 0xFFFFFFFF);
+            ...
+            simm_end();
+
+        simm_t2f() and simm_c4b(), simm_c4f() or simm_c1i() set the texture
+        coordinates and color of the following simm_v2f() and simm_v3f()
+        vertices. Colors are packed as 0xAABBGGRR.
+
+        For the highest throughput, reserve the vertices of a primitive
+        and write them directly:
+
+            simm_vertex* v = simm_alloc_vertices(num_sprites * 4);
+
+        The returned pointer is valid until the next sokol_imm.h call,
+        it's 0 if the vertices don't fit.
+
+        Incomplete primitives at the end of a simm_begin()/simm_end()
+        pair are discarded. If the vertices or batches run out, the whole
+        primitive is dropped (see simm_stats.num_dropped).
+
+    --- render all recorded primitives inside a sokol_gfx render pass:
+
+            sg_begin_default_pass(...);
+            simm_draw();
+            sg_end_pass();
+
+        simm_draw() resets the recorded primitives, it can be called
+        several times per frame, and it changes the scissor rect of the
+        current pass.
+
+    --- call simm_shutdown() before sg_shutdown().
+
+    On the software backend (SOKOL_SOFTWARE), only triangles, triangle
+    strips and quads are rendered.
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) the sokol_app_uwp contributors
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_IMM_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_imm.h"
+#endif
+
+#ifndef SOKOL_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_IMPL)
+#define SOKOL_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* a render state for primitives, see simm_make_pipeline() */
+typedef struct simm_pipeline { uint32_t id; } simm_pipeline;
+
+enum {
+    SIMM_INVALID_ID = 0,
+};
+
+typedef enum simm_primitive_type {
+    SIMM_PRIMITIVETYPE_POINTS,
+    SIMM_PRIMITIVETYPE_LINES,
+    SIMM_PRIMITIVETYPE_LINE_STRIP,
+    SIMM_PRIMITIVETYPE_TRIANGLES,
+    SIMM_PRIMITIVETYPE_TRIANGLE_STRIP,
+    SIMM_PRIMITIVETYPE_QUADS,
+    _SIMM_PRIMITIVETYPE_NUM,
+    _SIMM_PRIMITIVETYPE_FORCE_U32 = 0x7FFFFFFF
+} simm_primitive_type;
+
+/* the vertex layout in the stream buffer */
+typedef struct simm_vertex {
+    float x, y, z;
+    float u, v;
+    uint32_t color;     /* 0xAABBGGRR */
+} simm_vertex;
+
+typedef struct simm_desc {
+    int max_vertices;
+    int max_commands;
+    int pipeline_pool_size;
+    sg_pixel_format color_format;
+    sg_pixel_format depth_format;
+    int sample_count;
+} simm_desc;
+
+/* statistics of the last simm_draw() call */
+typedef struct simm_stats {
+    int num_vertices;       /* number of vertices copied into the stream buffer */
+    int num_commands;       /* number of batches after merging */
+    int num_merged;         /* number of simm_begin()/simm_end() pairs merged into the previous batch */
+    int num_draws;          /* number of sg_draw() calls */
+    int num_dropped;        /* number of primitives dropped because max_vertices or max_commands was reached */
+    bool buffer_overflow;   /* the stream buffer overflowed and nothing was rendered, it grows in sg_commit() */
+} simm_stats;
+
+SOKOL_API_DECL void simm_setup(const simm_desc* desc);
+SOKOL_API_DECL void simm_shutdown(void);
+SOKOL_API_DECL simm_pipeline simm_make_pipeline(const sg_pipeline_desc* desc);
+SOKOL_API_DECL void simm_destroy_pipeline(simm_pipeline pip);
+
+/* render state, only outside simm_begin()/simm_end() */
+SOKOL_API_DECL void simm_defaults(void);
+SOKOL_API_DECL void simm_load_pipeline(simm_pipeline pip);
+SOKOL_API_DECL void simm_texture(sg_image img);
+SOKOL_API_DECL void simm_scissor_rect(int x, int y, int w, int h, bool origin_top_left);
+SOKOL_API_DECL void simm_disable_scissor(void);
+SOKOL_API_DECL void simm_transform(const float m[16]);
+SOKOL_API_DECL void simm_ortho(float left, float right, float bottom, float top, float znear, float zfar);
+
+/* recording primitives */
+SOKOL_API_DECL void simm_begin(simm_primitive_type type);
+SOKOL_API_DECL void simm_end(void);
+SOKOL_API_DECL void simm_t2f(float u, float v);
+SOKOL_API_DECL void simm_c4b(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+SOKOL_API_DECL void simm_c4f(float r, float g, float b, float a);
+SOKOL_API_DECL void simm_c1i(uint32_t rgba);
+SOKOL_API_DECL void simm_v2f(float x, float y);
+SOKOL_API_DECL void simm_v3f(float x, float y, float z);
+SOKOL_API_DECL void simm_v2f_t2f_c1i(float x, float y, float u, float v, uint32_t rgba);
+SOKOL_API_DECL void simm_v3f_t2f_c1i(float x, float y, float z, float u, float v, uint32_t rgba);
+SOKOL_API_DECL simm_vertex* simm_alloc_vertices(int num);
+
+/* rendering, inside a sokol_gfx render pass */
+SOKOL_API_DECL void simm_draw(void);
+SOKOL_API_DECL simm_stats simm_query_stats(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* SOKOL_IMM_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_IMPL
+#define SOKOL_IMM_IMPL_INCLUDED (1)
+#include <string.h> /* memset, memcpy */
+
+#if defined(SOKOL_WGPU)
+#error "sokol_imm.h: the WebGPU backend isn't supported"
+#endif
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef SOKOL_LOG
+    #ifdef SOKOL_DEBUG
+        #include <stdio.h>
+        #define SOKOL_LOG(s) { SOKOL_ASSERT(s); puts(s); }
+    #else
+        #define SOKOL_LOG(s)
+    #endif
+#endif
+
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _simm_def(val, def) (((val) == 0) ? (def) : (val))
+
+enum {
+    _SIMM_DEFAULT_MAX_VERTICES = 262144,
+    _SIMM_DEFAULT_MAX_COMMANDS = 4096,
+    _SIMM_DEFAULT_PIPELINE_POOL_SIZE = 16,
+    /* quads are drawn in chunks which can be addressed with 16-bit indices */
+    _SIMM_QUAD_CHUNK_VERTICES = 65536,
+    _SIMM_QUAD_CHUNK_INDICES = (_SIMM_QUAD_CHUNK_VERTICES / 4) * 6,
+};
+
+/*-- embedded shaders --------------------------------------------------------*/
+#if defined(SOKOL_GLCORE33)
+static const char* _simm_vs_src =
+    "#version 330\n"
+    "uniform mat4 mvp;\n"
+    "layout(location=0) in vec4 position;\n"
+    "layout(location=1) in vec2 texcoord0;\n"
+    "layout(location=2) in vec4 color0;\n"
+    "out vec2 uv;\n"
+    "out vec4 color;\n"
+    "void main() {\n"
+    "  gl_Position = mvp * position;\n"
+    "  uv = texcoord0;\n"
+    "  color = color0;\n"
+    "}\n";
+static const char* _simm_fs_src =
+    "#version 330\n"
+    "uniform sampler2D tex;\n"
+    "in vec2 uv;\n"
+    "in vec4 color;\n"
+    "out vec4 frag_color;\n"
+    "void main() {\n"
+    "  frag_color = texture(tex, uv) * color;\n"
+    "}\n";
+#elif defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+static const char* _simm_vs_src =
+    "uniform mat4 mvp;\n"
+    "attribute vec4 position;\n"
+    "attribute vec2 texcoord0;\n"
+    "attribute vec4 color0;\n"
+    "varying vec2 uv;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "  gl_Position = mvp * position;\n"
+    "  uv = texcoord0;\n"
+    "  color = color0;\n"
+    "}\n";
+static const char* _simm_fs_src =
+    "precision mediump float;\n"
+    "uniform sampler2D tex;\n"
+    "varying vec2 uv;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "  gl_FragColor = texture2D(tex, uv) * color;\n"
+    "}\n";
+#elif defined(SOKOL_D3D11)
+static const char* _simm_vs_src =
+    "cbuffer params: register(b0) {\n"
+    "  float4x4 mvp;\n"
+    "};\n"
+    "struct vs_in {\n"
+    "  float4 pos: POSITION;\n"
+    "  float2 uv: TEXCOORD0;\n"
+    "  float4 color: COLOR0;\n"
+    "};\n"
+    "struct vs_out {\n"
+    "  float2 uv: TEXCOORD0;\n"
+    "  float4 color: COLOR0;\n"
+    "  float4 pos: SV_Position;\n"
+    "};\n"
+    "vs_out main(vs_in inp) {\n"
+    "  vs_out outp;\n"
+    "  outp.pos = mul(mvp, inp.pos);\n"
+    "  outp.uv = inp.uv;\n"
+    "  outp.color = inp.color;\n"
+    "  return outp;\n"
+    "}\n";
+static const char* _simm_fs_src =
+    "Texture2D<float4> tex: register(t0);\n"
+    "sampler smp: register(s0);\n"
+    "float4 main(float2 uv: TEXCOORD0, float4 color: COLOR0): SV_Target0 {\n"
+    "  return tex.Sample(smp, uv) * color;\n"
+    "}\n";
+#elif defined(SOKOL_METAL)
+static const char* _simm_vs_src =
+    "#include <metal_stdlib>\n"
+    "using namespace metal;\n"
+    "struct params_t {\n"
+    "  float4x4 mvp;\n"
+    "};\n"
+    "struct vs_in {\n"
+    "  float4 position [[attribute(0)]];\n"
+    "  float2 texcoord0 [[attribute(1)]];\n"
+    "  float4 color0 [[attribute(2)]];\n"
+    "};\n"
+    "struct vs_out {\n"
+    "  float4 pos [[position]];\n"
+    "  float2 uv;\n"
+    "  float4 color;\n"
+    "};\n"
+    "vertex vs_out _main(vs_in in [[stage_in]], constant params_t& params [[buffer(0)]]) {\n"
+    "  vs_out out;\n"
+    "  out.pos = params.mvp * in.position;\n"
+    "  out.uv = in.texcoord0;\n"
+    "  out.color = in.color0;\n"
+    "  return out;\n"
+    "}\n";
+static const char* _simm_fs_src =
+    "#include <metal_stdlib>\n"
+    "using namespace metal;\n"
+    "struct fs_in {\n"
+    "  float2 uv;\n"
+    "  float4 color;\n"
+    "};\n"
+    "fragment float4 _main(fs_in in [[stage_in]], texture2d<float> tex [[texture(0)]], sampler smp [[sampler(0)]]) {\n"
+    "  return tex.sample(smp, in.uv) * in.color;\n"
+    "}\n";
+#elif defined(SOKOL_SOFTWARE)
+/* the same shader as C callbacks, the varyings are the texture coords and the color */
+_SOKOL_PRIVATE void _simm_sw_vs(const sg_sw_vertex_input* in, sg_sw_vertex_output* out) {
+    const float* m = (const float*) in->uniforms[0];
+    const float* pos = in->attrs[0];
+    for (int r = 0; r < 4; r++) {
+        out->position[r] = m[r] * pos[0] + m[4 + r] * pos[1] + m[8 + r] * pos[2] + m[12 + r];
+    }
+    memcpy(&out->varyings[0], in->attrs[1], 2 * sizeof(float));
+    memcpy(&out->varyings[2], in->attrs[2], 4 * sizeof(float));
+}
+
+_SOKOL_PRIVATE bool _simm_sw_fs(const sg_sw_fragment_input* in, float out_color[4]) {
+    sg_sw_sample(in->textures[0], in->varyings[0], in->varyings[1], out_color);
+    for (int i = 0; i < 4; i++) {
+        out_color[i] *= in->varyings[2 + i];
+    }
+    return true;
+}
+#endif
+
+/*-- private state -----------------------------------------------------------*/
+typedef struct {
+    bool enabled;
+    bool origin_top_left;
+    int x, y, w, h;
+} _simm_scissor_t;
+
+/* a merged range of vertices with the same render state */
+typedef struct {
+    simm_primitive_type type;
+    uint32_t pip_id;
+    sg_image img;
+    _simm_scissor_t scissor;
+    int ub_index;
+    int base_vertex;
+    int num_vertices;
+} _simm_command_t;
+
+typedef struct {
+    float mvp[16];
+} _simm_uniforms_t;
+
+typedef struct {
+    sg_pipeline pip[_SIMM_PRIMITIVETYPE_NUM];   /* SG_INVALID_ID in .pip[0] if the pool slot is free */
+} _simm_pipeline_t;
+
+typedef struct {
+    bool valid;
+    bool in_begin;
+    simm_desc desc;
+    sg_allocator allocator;     /* the sg_desc.allocator callbacks of sokol_gfx.h */
+    sg_shader shd;
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    sg_image white_img;
+    simm_pipeline default_pip;
+    _simm_pipeline_t* pipelines;
+    /* recorded data since the last simm_draw() */
+    int num_vertices;
+    int num_commands;
+    int num_uniforms;
+    simm_vertex* vertices;
+    _simm_command_t* commands;
+    _simm_uniforms_t* uniforms;
+    /* current render state */
+    simm_pipeline cur_pip;
+    sg_image cur_img;
+    _simm_scissor_t cur_scissor;
+    float cur_mvp[16];
+    bool mvp_dirty;             /* cur_mvp isn't in uniforms[] yet */
+    int cur_ub_index;
+    float cur_u, cur_v;
+    uint32_t cur_color;
+    /* the primitive between simm_begin() and simm_end() */
+    simm_primitive_type cur_type;
+    int begin_vertex;
+    bool cur_overflow;
+    int num_merged;
+    int num_dropped;
+    simm_stats stats;
+} _simm_state_t;
+static _simm_state_t _simm;
+
+/*== PRIVATE FUNCTIONS =======================================================*/
+_SOKOL_PRIVATE void* _simm_malloc(size_t size, sg_alloc_category category) {
+    void* ptr;
+    if (_simm.allocator.alloc_fn) {
+        ptr = _simm.allocator.alloc_fn(size, category, _simm.allocator.user_data);
+    }
+    else {
+        ptr = SOKOL_MALLOC(size);
+    }
+    SOKOL_ASSERT(ptr);
+    return ptr;
+}
+
+_SOKOL_PRIVATE void _simm_free(void* ptr, sg_alloc_category category) {
+    if (0 == ptr) {
+        return;
+    }
+    if (_simm.allocator.free_fn) {
+        _simm.allocator.free_fn(ptr, category, _simm.allocator.user_data);
+    }
+    else {
+        SOKOL_FREE(ptr);
+    }
+}
+
+_SOKOL_PRIVATE void _simm_identity(float m[16]) {
+    memset(m, 0, 16 * sizeof(float));
+    m[0] = m[5] = m[10] = m[15] = 1.0f;
+}
+
+_SOKOL_PRIVATE uint32_t _simm_pack_color(float r, float g, float b, float a) {
+    const float c[4] = { r, g, b, a };
+    uint32_t rgba = 0;
+    for (int i = 0; i < 4; i++) {
+        const float f = (c[i] < 0.0f) ? 0.0f : ((c[i] > 1.0f) ? 1.0f : c[i]);
+        rgba |= ((uint32_t)(f * 255.0f + 0.5f)) << (i * 8);
+    }
+    return rgba;
+}
+
+_SOKOL_PRIVATE void _simm_make_shader(void) {
+    sg_shader_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.attrs[0].name = "position";
+    desc.attrs[0].sem_name = "POSITION";
+    desc.attrs[1].name = "texcoord0";
+    desc.attrs[1].sem_name = "TEXCOORD";
+    desc.attrs[2].name = "color0";
+    desc.attrs[2].sem_name = "COLOR";
+    desc.vs.uniform_blocks[0].size = sizeof(_simm_uniforms_t);
+    desc.vs.uniform_blocks[0].uniforms[0].name = "mvp";
+    desc.vs.uniform_blocks[0].uniforms[0].type = SG_UNIFORMTYPE_MAT4;
+    desc.fs.images[0].name = "tex";
+    desc.fs.images[0].type = SG_IMAGETYPE_2D;
+    #if defined(SOKOL_SOFTWARE)
+        desc.sw.vs = _simm_sw_vs;
+        desc.sw.fs = _simm_sw_fs;
+        desc.sw.num_varyings = 6;
+    #elif !defined(SOKOL_DUMMY_BACKEND)
+        desc.vs.source = _simm_vs_src;
+        desc.fs.source = _simm_fs_src;
+    #endif
+    desc.label = "sokol-imm-shader";
+    _simm.shd = sg_make_shader(&desc);
+}
+
+_SOKOL_PRIVATE void _simm_make_resources(void) {
+    sg_buffer_desc vbuf_desc;
+    memset(&vbuf_desc, 0, sizeof(vbuf_desc));
+    vbuf_desc.size = _simm.desc.max_vertices * (int)sizeof(simm_vertex);
+    vbuf_desc.usage = SG_USAGE_STREAM;
+    vbuf_desc.append_grow = true;
+    vbuf_desc.label = "sokol-imm-vertices";
+    _simm.vbuf = sg_make_buffer(&vbuf_desc);
+
+    /* a shared index buffer which draws 4 vertices as a quad made of two triangles */
+    const size_t ib_size = _SIMM_QUAD_CHUNK_INDICES * sizeof(uint16_t);
+    uint16_t* indices = (uint16_t*) _simm_malloc(ib_size, SG_ALLOCCATEGORY_TEMP);
+    for (int q = 0; q < (_SIMM_QUAD_CHUNK_VERTICES / 4); q++) {
+        const uint16_t base = (uint16_t)(q * 4);
+        uint16_t* dst = &indices[q * 6];
+        dst[0] = base; dst[1] = (uint16_t)(base + 1); dst[2] = (uint16_t)(base + 2);
+        dst[3] = base; dst[4] = (uint16_t)(base + 2); dst[5] = (uint16_t)(base + 3);
+    }
+    sg_buffer_desc ibuf_desc;
+    memset(&ibuf_desc, 0, sizeof(ibuf_desc));
+    ibuf_desc.size = (int)ib_size;
+    ibuf_desc.type = SG_BUFFERTYPE_INDEXBUFFER;
+    ibuf_desc.content = indices;
+    ibuf_desc.label = "sokol-imm-quad-indices";
+    _simm.ibuf = sg_make_buffer(&ibuf_desc);
+    _simm_free(indices, SG_ALLOCCATEGORY_TEMP);
+
+    /* bound when no texture is used */
+    static const uint32_t white_pixel = 0xFFFFFFFF;
+    sg_image_desc img_desc;
+    memset(&img_desc, 0, sizeof(img_desc));
+    img_desc.width = 1;
+    img_desc.height = 1;
+    img_desc.pixel_format = SG_PIXELFORMAT_RGBA8;
+    img_desc.content.subimage[0][0].ptr = &white_pixel;
+    img_desc.content.subimage[0][0].size = sizeof(white_pixel);
+    img_desc.label = "sokol-imm-white-texture";
+    _simm.white_img = sg_make_image(&img_desc);
+}
+
+_SOKOL_PRIVATE _simm_pipeline_t* _simm_lookup_pipeline(uint32_t pip_id) {
+    if (SIMM_INVALID_ID == pip_id) {
+        return 0;
+    }
+    const int index = (int)pip_id - 1;
+    SOKOL_ASSERT((index >= 0) && (index < _simm.desc.pipeline_pool_size));
+    _simm_pipeline_t* pip = &_simm.pipelines[index];
+    return (SG_INVALID_ID != pip->pip[0].id) ? pip : 0;
+}
+
+_SOKOL_PRIVATE bool _simm_scissor_equal(const _simm_scissor_t* a, const _simm_scissor_t* b) {
+    if (a->enabled != b->enabled) {
+        return false;
+    }
+    if (!a->enabled) {
+        return true;
+    }
+    return (a->origin_top_left == b->origin_top_left) &&
+           (a->x == b->x) && (a->y == b->y) && (a->w == b->w) && (a->h == b->h);
+}
+
+_SOKOL_PRIVATE void _simm_apply_scissor(const _simm_scissor_t* sc) {
+    if (sc->enabled) {
+        sg_apply_scissor_rect(sc->x, sc->y, sc->w, sc->h, sc->origin_top_left);
+    }
+    else {
+        /* the backends clip the scissor rect against the render target */
+        sg_apply_scissor_rect(0, 0, 1<<16, 1<<16, true);
+    }
+}
+
+/* number of vertices per primitive, incomplete primitives are discarded */
+_SOKOL_PRIVATE int _simm_vertices_per_primitive(simm_primitive_type type) {
+    switch (type) {
+        case SIMM_PRIMITIVETYPE_LINES:      return 2;
+        case SIMM_PRIMITIVETYPE_TRIANGLES:  return 3;
+        case SIMM_PRIMITIVETYPE_QUADS:      return 4;
+        default:                            return 1;
+    }
+}
+
+_SOKOL_PRIVATE int _simm_min_vertices(simm_primitive_type type) {
+    switch (type) {
+        case SIMM_PRIMITIVETYPE_LINE_STRIP:     return 2;
+        case SIMM_PRIMITIVETYPE_TRIANGLE_STRIP: return 3;
+        default:                                return _simm_vertices_per_primitive(type);
+    }
+}
+
+/* strips can't be merged, this would connect them */
+_SOKOL_PRIVATE bool _simm_can_merge(const _simm_command_t* cmd, int begin_vertex) {
+    return (cmd->type == _simm.cur_type) &&
+           (cmd->type != SIMM_PRIMITIVETYPE_LINE_STRIP) &&
+           (cmd->type != SIMM_PRIMITIVETYPE_TRIANGLE_STRIP) &&
+           (cmd->pip_id == _simm.cur_pip.id) &&
+           (cmd->img.id == _simm.cur_img.id) &&
+           (cmd->ub_index == _simm.cur_ub_index) &&
+           ((cmd->base_vertex + cmd->num_vertices) == begin_vertex) &&
+           _simm_scissor_equal(&cmd->scissor, &_simm.cur_scissor);
+}
+
+_SOKOL_PRIVATE void _simm_vertex(float x, float y, float z, float u, float v, uint32_t rgba) {
+    SOKOL_ASSERT(_simm.in_begin);
+    if (_simm.num_vertices < _simm.desc.max_vertices) {
+        simm_vertex* vtx = &_simm.vertices[_simm.num_vertices++];
+        vtx->x = x;
+        vtx->y = y;
+        vtx->z = z;
+        vtx->u = u;
+        vtx->v = v;
+        vtx->color = rgba;
+    }
+    else {
+        _simm.cur_overflow = true;
+    }
+}
+
+_SOKOL_PRIVATE void _simm_draw_commands(int vb_offset, simm_stats* stats) {
+    sg_pipeline cur_pip = { SG_INVALID_ID };
+    sg_image cur_img = { SG_INVALID_ID };
+    int cur_ub_index = -1;
+    int cur_vb_offset = -1;
+    bool scissor_valid = false;
+    _simm_scissor_t cur_scissor;
+    memset(&cur_scissor, 0, sizeof(cur_scissor));
+    sg_bindings bind;
+    memset(&bind, 0, sizeof(bind));
+    bind.vertex_buffers[0] = _simm.vbuf;
+    for (int i = 0; i < _simm.num_commands; i++) {
+        const _simm_command_t* cmd = &_simm.commands[i];
+        const _simm_pipeline_t* pip = _simm_lookup_pipeline(cmd->pip_id);
+        if (0 == pip) {
+            continue;
+        }
+        bool rebind = false;
+        if (pip->pip[cmd->type].id != cur_pip.id) {
+            cur_pip = pip->pip[cmd->type];
+            sg_apply_pipeline(cur_pip);
+            rebind = true;
+            cur_ub_index = -1;
+        }
+        if (!scissor_valid || !_simm_scissor_equal(&cmd->scissor, &cur_scissor)) {
+            cur_scissor = cmd->scissor;
+            scissor_valid = true;
+            _simm_apply_scissor(&cur_scissor);
+        }
+        const sg_image img = (SG_INVALID_ID != cmd->img.id) ? cmd->img : _simm.white_img;
+        if (img.id != cur_img.id) {
+            cur_img = img;
+            rebind = true;
+        }
+        bind.fs_images[0] = cur_img;
+        const bool quads = (SIMM_PRIMITIVETYPE_QUADS == cmd->type);
+        bind.index_buffer.id = quads ? _simm.ibuf.id : (uint32_t)SG_INVALID_ID;
+        int first = 0;
+        do {
+            /* quads use the shared index buffer and move the vertex buffer offset instead of base_element */
+            const int num = quads ? (cmd->num_vertices - first) : cmd->num_vertices;
+            const int chunk = (num > _SIMM_QUAD_CHUNK_VERTICES) ? _SIMM_QUAD_CHUNK_VERTICES : num;
+            const int offset = quads ? (vb_offset + (cmd->base_vertex + first) * (int)sizeof(simm_vertex)) : vb_offset;
+            if (rebind || (offset != cur_vb_offset)) {
+                bind.vertex_buffer_offsets[0] = offset;
+                sg_apply_bindings(&bind);
+                cur_vb_offset = offset;
+                rebind = false;
+            }
+            if (cmd->ub_index != cur_ub_index) {
+                cur_ub_index = cmd->ub_index;
+                sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &_simm.uniforms[cur_ub_index], sizeof(_simm_uniforms_t));
+            }
+            if (quads) {
+                sg_draw(0, (chunk / 4) * 6, 1);
+                first += chunk;
+            }
+            else {
+                sg_draw(cmd->base_vertex, cmd->num_vertices, 1);
+                first = cmd->num_vertices;
+            }
+            stats->num_draws++;
+        } while (first < cmd->num_vertices);
+    }
+    if (scissor_valid && cur_scissor.enabled) {
+        _simm_scissor_t no_scissor;
+        memset(&no_scissor, 0, sizeof(no_scissor));
+        _simm_apply_scissor(&no_scissor);
+    }
+}
+
+/*== PUBLIC FUNCTIONS ========================================================*/
+SOKOL_API_IMPL void simm_setup(const simm_desc* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(sg_isvalid());
+    memset(&_simm, 0, sizeof(_simm));
+    _simm.desc = *desc;
+    _simm.desc.max_vertices = _simm_def(_simm.desc.max_vertices, _SIMM_DEFAULT_MAX_VERTICES);
+    _simm.desc.max_commands = _simm_def(_simm.desc.max_commands, _SIMM_DEFAULT_MAX_COMMANDS);
+    _simm.desc.pipeline_pool_size = _simm_def(_simm.desc.pipeline_pool_size, _SIMM_DEFAULT_PIPELINE_POOL_SIZE);
+    const sg_desc gfx_desc = sg_query_desc();
+    _simm.desc.color_format = _simm_def(_simm.desc.color_format, gfx_desc.context.color_format);
+    _simm.desc.depth_format = _simm_def(_simm.desc.depth_format, gfx_desc.context.depth_format);
+    _simm.desc.sample_count = _simm_def(_simm.desc.sample_count, gfx_desc.context.sample_count);
+    _simm.allocator = gfx_desc.allocator;
+
+    _simm.vertices = (simm_vertex*) _simm_malloc(sizeof(simm_vertex) * (size_t)_simm.desc.max_vertices, SG_ALLOCCATEGORY_RESOURCES);
+    _simm.commands = (_simm_command_t*) _simm_malloc(sizeof(_simm_command_t) * (size_t)_simm.desc.max_commands, SG_ALLOCCATEGORY_RESOURCES);
+    /* each batch needs at most one transform */
+    _simm.uniforms = (_simm_uniforms_t*) _simm_malloc(sizeof(_simm_uniforms_t) * (size_t)_simm.desc.max_commands, SG_ALLOCCATEGORY_RESOURCES);
+    const size_t pipelines_size = sizeof(_simm_pipeline_t) * (size_t)_simm.desc.pipeline_pool_size;
+    _simm.pipelines = (_simm_pipeline_t*) _simm_malloc(pipelines_size, SG_ALLOCCATEGORY_RESOURCES);
+    memset(_simm.pipelines, 0, pipelines_size);
+
+    _simm_make_shader();
+    _simm_make_resources();
+    _simm.valid = true;
+
+    /* alpha blending, no depth test and no culling */
+    sg_pipeline_desc pip_desc;
+    memset(&pip_desc, 0, sizeof(pip_desc));
+    pip_desc.blend.enabled = true;
+    pip_desc.blend.src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA;
+    pip_desc.blend.dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    pip_desc.label = "sokol-imm-default-pipeline";
+    _simm.default_pip = simm_make_pipeline(&pip_desc);
+    simm_defaults();
+}
+
+SOKOL_API_IMPL void simm_shutdown(void) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    for (int i = 0; i < _simm.desc.pipeline_pool_size; i++) {
+        const simm_pipeline pip = { (uint32_t)(i + 1) };
+        simm_destroy_pipeline(pip);
+    }
+    sg_destroy_image(_simm.white_img);
+    sg_destroy_buffer(_simm.ibuf);
+    sg_destroy_buffer(_simm.vbuf);
+    sg_destroy_shader(_simm.shd);
+    _simm_free(_simm.pipelines, SG_ALLOCCATEGORY_RESOURCES);
+    _simm_free(_simm.uniforms, SG_ALLOCCATEGORY_RESOURCES);
+    _simm_free(_simm.commands, SG_ALLOCCATEGORY_RESOURCES);
+    _simm_free(_simm.vertices, SG_ALLOCCATEGORY_RESOURCES);
+    _simm.valid = false;
+}
+
+SOKOL_API_IMPL simm_pipeline simm_make_pipeline(const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(_simm.valid && desc);
+    simm_pipeline result = { SIMM_INVALID_ID };
+    int index = 0;
+    while ((index < _simm.desc.pipeline_pool_size) && (SG_INVALID_ID != _simm.pipelines[index].pip[0].id)) {
+        index++;
+    }
+    if (index == _simm.desc.pipeline_pool_size) {
+        SOKOL_LOG("sokol_imm.h: pipeline pool exhausted (see simm_desc.pipeline_pool_size)");
+        return result;
+    }
+    sg_pipeline_desc pip_desc = *desc;
+    memset(&pip_desc.layout, 0, sizeof(pip_desc.layout));
+    pip_desc.layout.buffers[0].stride = sizeof(simm_vertex);
+    pip_desc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3;
+    pip_desc.layout.attrs[1].format = SG_VERTEXFORMAT_FLOAT2;
+    pip_desc.layout.attrs[2].format = SG_VERTEXFORMAT_UBYTE4N;
+    pip_desc.shader = _simm.shd;
+    pip_desc.blend.color_format = _simm_def(pip_desc.blend.color_format, _simm.desc.color_format);
+    pip_desc.blend.depth_format = _simm_def(pip_desc.blend.depth_format, _simm.desc.depth_format);
+    pip_desc.rasterizer.sample_count = _simm_def(pip_desc.rasterizer.sample_count, _simm.desc.sample_count);
+    _simm_pipeline_t* pip = &_simm.pipelines[index];
+    for (int i = 0; i < _SIMM_PRIMITIVETYPE_NUM; i++) {
+        switch ((simm_primitive_type)i) {
+            case SIMM_PRIMITIVETYPE_POINTS:         pip_desc.primitive_type = SG_PRIMITIVETYPE_POINTS; break;
+            case SIMM_PRIMITIVETYPE_LINES:          pip_desc.primitive_type = SG_PRIMITIVETYPE_LINES; break;
+            case SIMM_PRIMITIVETYPE_LINE_STRIP:     pip_desc.primitive_type = SG_PRIMITIVETYPE_LINE_STRIP; break;
+            case SIMM_PRIMITIVETYPE_TRIANGLE_STRIP: pip_desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP; break;
+            default:                                pip_desc.primitive_type = SG_PRIMITIVETYPE_TRIANGLES; break;
+        }
+        pip_desc.index_type = (SIMM_PRIMITIVETYPE_QUADS == i) ? SG_INDEXTYPE_UINT16 : SG_INDEXTYPE_NONE;
+        pip->pip[i] = sg_make_pipeline(&pip_desc);
+    }
+    result.id = (uint32_t)(index + 1);
+    return result;
+}
+
+SOKOL_API_IMPL void simm_destroy_pipeline(simm_pipeline pip_id) {
+    SOKOL_ASSERT(_simm.valid);
+    _simm_pipeline_t* pip = _simm_lookup_pipeline(pip_id.id);
+    if (pip) {
+        for (int i = 0; i < _SIMM_PRIMITIVETYPE_NUM; i++) {
+            sg_destroy_pipeline(pip->pip[i]);
+        }
+        memset(pip, 0, sizeof(_simm_pipeline_t));
+    }
+}
+
+SOKOL_API_IMPL void simm_defaults(void) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    _simm.cur_pip = _simm.default_pip;
+    _simm.cur_img.id = SG_INVALID_ID;
+    memset(&_simm.cur_scissor, 0, sizeof(_simm.cur_scissor));
+    _simm_identity(_simm.cur_mvp);
+    _simm.mvp_dirty = true;
+    _simm.cur_u = 0.0f;
+    _simm.cur_v = 0.0f;
+    _simm.cur_color = 0xFFFFFFFF;
+}
+
+SOKOL_API_IMPL void simm_load_pipeline(simm_pipeline pip) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    _simm.cur_pip = pip;
+}
+
+SOKOL_API_IMPL void simm_texture(sg_image img) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    _simm.cur_img = img;
+}
+
+SOKOL_API_IMPL void simm_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    _simm.cur_scissor.enabled = true;
+    _simm.cur_scissor.origin_top_left = origin_top_left;
+    _simm.cur_scissor.x = x;
+    _simm.cur_scissor.y = y;
+    _simm.cur_scissor.w = w;
+    _simm.cur_scissor.h = h;
+}
+
+SOKOL_API_IMPL void simm_disable_scissor(void) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    memset(&_simm.cur_scissor, 0, sizeof(_simm.cur_scissor));
+}
+
+SOKOL_API_IMPL void simm_transform(const float m[16]) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin && m);
+    if (0 != memcmp(_simm.cur_mvp, m, sizeof(_simm.cur_mvp))) {
+        memcpy(_simm.cur_mvp, m, sizeof(_simm.cur_mvp));
+        _simm.mvp_dirty = true;
+    }
+}
+
+SOKOL_API_IMPL void simm_ortho(float left, float right, float bottom, float top, float znear, float zfar) {
+    float m[16];
+    memset(m, 0, sizeof(m));
+    m[0] = 2.0f / (right - left);
+    m[5] = 2.0f / (top - bottom);
+    m[10] = -2.0f / (zfar - znear);
+    m[12] = -(right + left) / (right - left);
+    m[13] = -(top + bottom) / (top - bottom);
+    m[14] = -(zfar + znear) / (zfar - znear);
+    m[15] = 1.0f;
+    simm_transform(m);
+}
+
+SOKOL_API_IMPL void simm_begin(simm_primitive_type type) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    SOKOL_ASSERT((type >= 0) && (type < _SIMM_PRIMITIVETYPE_NUM));
+    _simm.in_begin = true;
+    _simm.cur_type = type;
+    _simm.begin_vertex = _simm.num_vertices;
+    _simm.cur_overflow = false;
+}
+
+SOKOL_API_IMPL void simm_end(void) {
+    SOKOL_ASSERT(_simm.valid && _simm.in_begin);
+    _simm.in_begin = false;
+    int num = _simm.num_vertices - _simm.begin_vertex;
+    if (_simm.cur_type != SIMM_PRIMITIVETYPE_LINE_STRIP && _simm.cur_type != SIMM_PRIMITIVETYPE_TRIANGLE_STRIP) {
+        num -= num % _simm_vertices_per_primitive(_simm.cur_type);
+    }
+    if (_simm.cur_overflow) {
+        _simm.num_dropped++;
+        num = 0;
+    }
+    if (num < _simm_min_vertices(_simm.cur_type)) {
+        _simm.num_vertices = _simm.begin_vertex;
+        return;
+    }
+    _simm.num_vertices = _simm.begin_vertex + num;
+
+    /* a changed transform needs a new uniform block, which also prevents merging */
+    if (_simm.mvp_dirty) {
+        if (_simm.num_uniforms == _simm.desc.max_commands) {
+            _simm.num_dropped++;
+            _simm.num_vertices = _simm.begin_vertex;
+            return;
+        }
+        _simm.cur_ub_index = _simm.num_uniforms++;
+        memcpy(_simm.uniforms[_simm.cur_ub_index].mvp, _simm.cur_mvp, sizeof(_simm.cur_mvp));
+        _simm.mvp_dirty = false;
+    }
+    if (_simm.num_commands > 0) {
+        _simm_command_t* prev = &_simm.commands[_simm.num_commands - 1];
+        if (_simm_can_merge(prev, _simm.begin_vertex)) {
+            prev->num_vertices += num;
+            _simm.num_merged++;
+            return;
+        }
+    }
+    if (_simm.num_commands == _simm.desc.max_commands) {
+        _simm.num_dropped++;
+        _simm.num_vertices = _simm.begin_vertex;
+        return;
+    }
+    _simm_command_t* cmd = &_simm.commands[_simm.num_commands++];
+    cmd->type = _simm.cur_type;
+    cmd->pip_id = _simm.cur_pip.id;
+    cmd->img = _simm.cur_img;
+    cmd->scissor = _simm.cur_scissor;
+    cmd->ub_index = _simm.cur_ub_index;
+    cmd->base_vertex = _simm.begin_vertex;
+    cmd->num_vertices = num;
+}
+
+SOKOL_API_IMPL void simm_t2f(float u, float v) {
+    _simm.cur_u = u;
+    _simm.cur_v = v;
+}
+
+SOKOL_API_IMPL void simm_c4b(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    _simm.cur_color = (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+}
+
+SOKOL_API_IMPL void simm_c4f(float r, float g, float b, float a) {
+    _simm.cur_color = _simm_pack_color(r, g, b, a);
+}
+
+SOKOL_API_IMPL void simm_c1i(uint32_t rgba) {
+    _simm.cur_color = rgba;
+}
+
+SOKOL_API_IMPL void simm_v2f(float x, float y) {
+    _simm_vertex(x, y, 0.0f, _simm.cur_u, _simm.cur_v, _simm.cur_color);
+}
+
+SOKOL_API_IMPL void simm_v3f(float x, float y, float z) {
+    _simm_vertex(x, y, z, _simm.cur_u, _simm.cur_v, _simm.cur_color);
+}
+
+SOKOL_API_IMPL void simm_v2f_t2f_c1i(float x, float y, float u, float v, uint32_t rgba) {
+    _simm_vertex(x, y, 0.0f, u, v, rgba);
+}
+
+SOKOL_API_IMPL void simm_v3f_t2f_c1i(float x, float y, float z, float u, float v, uint32_t rgba) {
+    _simm_vertex(x, y, z, u, v, rgba);
+}
+
+SOKOL_API_IMPL simm_vertex* simm_alloc_vertices(int num) {
+    SOKOL_ASSERT(_simm.in_begin && (num > 0));
+    if ((_simm.num_vertices + num) > _simm.desc.max_vertices) {
+        _simm.cur_overflow = true;
+        return 0;
+    }
+    simm_vertex* ptr = &_simm.vertices[_simm.num_vertices];
+    _simm.num_vertices += num;
+    return ptr;
+}
+
+SOKOL_API_IMPL void simm_draw(void) {
+    SOKOL_ASSERT(_simm.valid && !_simm.in_begin);
+    simm_stats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.num_vertices = _simm.num_vertices;
+    stats.num_commands = _simm.num_commands;
+    stats.num_merged = _simm.num_merged;
+    stats.num_dropped = _simm.num_dropped;
+    if (_simm.num_commands > 0) {
+        const int vb_offset = sg_append_buffer(_simm.vbuf, _simm.vertices, _simm.num_vertices * (int)sizeof(simm_vertex));
+        if (sg_query_buffer_overflow(_simm.vbuf)) {
+            stats.buffer_overflow = true;
+        }
+        else {
+            _simm_draw_commands(vb_offset, &stats);
+        }
+    }
+    _simm.stats = stats;
+    _simm.num_vertices = 0;
+    _simm.num_commands = 0;
+    _simm.num_uniforms = 0;
+    _simm.num_merged = 0;
+    _simm.num_dropped = 0;
+    _simm.mvp_dirty = true;
+}
+
+SOKOL_API_IMPL simm_stats simm_query_stats(void) {
+    SOKOL_ASSERT(_simm.valid);
+    return _simm.stats;
+}
+
+#endif /* SOKOL_IMPL */
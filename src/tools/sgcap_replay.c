@@ -0,0 +1,112 @@
+/*
+    sgcap_replay.c -- replay a sokol_gfx_capture.h capture file and print call timings
+
+    Replays the capture on the sokol_gfx dummy backend, this measures the
+    CPU overhead of sokol_gfx itself without a GPU or window. To replay on
+    a real backend, call the sgcap_replay_*() functions from an application
+    which has set up a rendering context.
+
+    Build with the CMake option SOKOL_GFX_CAPTURE=ON (desktop builds only,
+    this also compiles the capture recorder into the sample app), or
+    directly (from the src directory):
+
+        cc -O2 -Isokol tools/sgcap_replay.c -o sgcap_replay
+
+    Usage:
+
+        sgcap_replay <capture-file> [num-runs]
+*/
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sokol_gfx.h"
+#include "sokol_gfx_capture.h"
+
+static void* load_file(const char* path, int* out_size) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    const long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    void* data = malloc((size_t)size);
+    if (data && (fread(data, 1, (size_t)size, fp) != (size_t)size)) {
+        free(data);
+        data = 0;
+    }
+    fclose(fp);
+    *out_size = (int)size;
+    return data;
+}
+
+static double ms(uint64_t ns) {
+    return (double)ns / 1000000.0;
+}
+
+static double us(uint64_t ns) {
+    return (double)ns / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture-file> [num-runs]\n", argv[0]);
+        return 10;
+    }
+    const int num_runs = (argc > 2) ? atoi(argv[2]) : 1;
+    int size = 0;
+    void* data = load_file(argv[1], &size);
+    if (!data) {
+        fprintf(stderr, "failed to load '%s'\n", argv[1]);
+        return 10;
+    }
+    sgcap_capture_info info;
+    if (!sgcap_query_capture_info(data, size, &info)) {
+        fprintf(stderr, "'%s' is not a valid capture\n", argv[1]);
+        return 10;
+    }
+    printf("capture: %d frames, %d calls, recorded on backend %d\n", info.num_frames, info.num_calls, (int)info.backend);
+
+    sg_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.buffer_pool_size = info.buffer_pool_size;
+    desc.image_pool_size = info.image_pool_size;
+    desc.shader_pool_size = info.shader_pool_size;
+    desc.pipeline_pool_size = info.pipeline_pool_size;
+    desc.pass_pool_size = info.pass_pool_size;
+    desc.occlusion_query_pool_size = info.occlusion_query_pool_size;
+    sg_setup(&desc);
+
+    for (int run = 0; run < num_runs; run++) {
+        if (!sgcap_replay_begin(data, size)) {
+            return 10;
+        }
+        while (sgcap_replay_frame()) { }
+        const sgcap_replay_stats stats = sgcap_query_replay_stats();
+        sgcap_replay_end();
+
+        printf("\nrun %d: %d frames, avg %.3f ms, min %.3f ms, max %.3f ms\n",
+            run + 1,
+            stats.num_frames,
+            stats.num_frames > 0 ? ms(stats.total_frame_ns) / stats.num_frames : 0.0,
+            ms(stats.min_frame_ns),
+            ms(stats.max_frame_ns));
+        printf("  %-26s %10s %12s %10s %10s\n", "call", "count", "total ms", "avg us", "max us");
+        for (int i = 0; i < SGCAP_CMD_NUM; i++) {
+            const sgcap_call_stats* call = &stats.calls[i];
+            if (call->num_calls > 0) {
+                printf("  %-26s %10d %12.3f %10.3f %10.3f\n",
+                    call->name,
+                    call->num_calls,
+                    ms(call->total_ns),
+                    us(call->total_ns) / call->num_calls,
+                    us(call->max_ns));
+            }
+        }
+    }
+    sg_shutdown();
+    free(data);
+    return 0;
+}